@@ -60,7 +60,153 @@ enum WPSCreator { WPS_MSWORKS=0 /** Microsoft Works documents (all wps, wks and
                   WPS_POCKETWORD=WPS_RESERVED_4 /** Pocket Word*/
                 };
 enum WPSKind { WPS_TEXT=0, WPS_SPREADSHEET, WPS_DATABASE };
-enum WPSResult { WPS_OK, WPS_ENCRYPTION_ERROR, WPS_FILE_ACCESS_ERROR, WPS_PARSE_ERROR, WPS_OLE_ERROR, WPS_UNKNOWN_ERROR };
+enum WPSResult { WPS_OK, WPS_ENCRYPTION_ERROR, WPS_FILE_ACCESS_ERROR, WPS_PARSE_ERROR, WPS_OLE_ERROR, WPS_UNKNOWN_ERROR, WPS_LIMIT_EXCEEDED_ERROR, WPS_CANCELLED_ERROR };
+
+/**
+This class can be used to follow the progression of a parsing and to cancel it.
+*/
+class WPSParseCallback
+{
+public:
+	//! destructor
+	virtual ~WPSParseCallback()
+	{
+	}
+	/** called from time to time by the parsers when they read the document's zones
+	   \param position the number of bytes of the actual stream which are consumed
+	   \param size the actual stream's size
+	   \return false to cancel the parsing, WPSDocument::parse then returns WPS_CANCELLED_ERROR
+	*/
+	virtual bool progress(long position, long size)=0;
+};
+
+/**
+This class stores the statistics collected during a parsing when profiling is enabled:
+for each zone (a record type or a named zone) of each parser, the number of zones, their size,
+the time spent to decode them and the time spent to send their content to the interface.
+If several documents are parsed with the same profile, the statistics are accumulated.
+
+The memory used by the parsing can also be attributed to some subsystems (cells, styles,
+formulas, OLE streams, embedded objects, listener) if the application hooks its global operator
+new and delete and calls memoryAllocated and memoryFreed.
+*/
+class WPSLIB WPSParseProfile
+{
+public:
+	//! constructor
+	WPSParseProfile();
+	//! destructor
+	~WPSParseProfile();
+	//! resets the statistics
+	void clear();
+	//! returns true if no zone was profiled
+	bool empty() const;
+	/** adds the statistics of a zone
+	   \param parser the parser's name
+	   \param zone the zone's name
+	   \param count the number of zones
+	   \param bytes the size of the zones in bytes
+	   \param decodeTime the time spent to decode the zones in seconds (without the time spent in the sub zones)
+	   \param emitTime the time spent to send the zones' content to the interface in seconds
+	*/
+	void addZone(char const *parser, char const *zone, long count, long bytes, double decodeTime, double emitTime);
+	//! adds the total time of a parsing in seconds
+	void addParsing(double time);
+	/** adds the memory statistics of a subsystem
+	   \param subsystem the subsystem's name: cells, styles, formulas, oleStreams, embeddedObjects, listener, other or total
+	   \param numAllocations the number of allocations
+	   \param bytes the allocated size in bytes
+	   \param peak the maximal size allocated at the same time in bytes
+	*/
+	void addMemory(char const *subsystem, long numAllocations, long bytes, long peak);
+	/** registers an allocation of size bytes in the profiling parsing of the actual thread (if any).
+	   This function must be called by the application's operator new to obtain the memory statistics.
+	   \return a token which must be given to memoryFreed when the block is freed
+	   \note this function does not allocate memory
+	*/
+	static unsigned long memoryAllocated(unsigned long size);
+	//! registers that a block allocated with the token returned by memoryAllocated is freed
+	static void memoryFreed(unsigned long token, unsigned long size);
+	/** returns the statistics in JSON format, the zones being sorted by decreasing time:
+	   { "parsings": 1, "totalTime": 0.5, "zones": [{ "parser": "Lotus", "zone": "0x16", "count": 10, "bytes": 200, "decodeTime": 0.1, "emitTime": 0.2 }, ...],
+	     "memory": [{ "subsystem": "cells", "allocations": 100, "bytes": 4000, "peak": 3000 }, ...] }
+	   the memory entry only exists if some allocations are registered.
+	*/
+	librevenge::RVNGString getJSON() const;
+private:
+	WPSParseProfile(WPSParseProfile const &) = delete;
+	WPSParseProfile &operator=(WPSParseProfile const &) = delete;
+	//! the internal data
+	struct Data;
+	//! the internal data
+	Data *m_data;
+};
+
+/**
+This structure stores the resource limits of a parsing. If a limit is exceeded,
+the parsing is stopped and WPS_LIMIT_EXCEEDED_ERROR is returned. A value of 0 means no limit.
+*/
+struct WPSParseLimits
+{
+	//! constructor: by default, there is no limit
+	WPSParseLimits()
+		: m_maxCells(0)
+		, m_maxMemory(0)
+		, m_maxRecords(0)
+		, m_maxTime(0)
+	{
+	}
+	/** the maximum number of spreadsheet cells sent to the interface (the repeated cells are counted),
+		this limit is also checked on the cells and columns created while the file is read */
+	long m_maxCells;
+	//! the maximum number of bytes of data which can be read and kept in memory (pictures, embedded objects, ...)
+	long m_maxMemory;
+	//! the maximum number of records which can be read or sent (zones, paragraphs, tables' cells, ...)
+	long m_maxRecords;
+	//! the maximum parsing time in seconds
+	double m_maxTime;
+};
+
+/**
+This structure stores the optional parameters which can be used to modify the parsing.
+*/
+struct WPSParseOptions
+{
+	//! constructor: by default, all the document's content is retrieved
+	WPSParseOptions()
+		: m_skipBinaryData(false)
+		, m_skipGraphics(false)
+		, m_skipCharts(false)
+		, m_skipComments(false)
+		, m_skipStyles(false)
+		, m_limits()
+		, m_callback(nullptr)
+		, m_profile(nullptr)
+		, m_numThreads(1)
+	{
+	}
+	/** a flag to skip the embedded objects: the pictures and the OLE's data are
+		not read and no binary object is sent to the interface */
+	bool m_skipBinaryData;
+	/** spreadsheet: a flag to skip the graphic zones (shapes, textboxes, pictures) */
+	bool m_skipGraphics;
+	/** spreadsheet: a flag to skip the chart zones */
+	bool m_skipCharts;
+	/** spreadsheet: a flag to skip the cell's comments */
+	bool m_skipComments;
+	/** spreadsheet: a flag to skip the style zones (fonts, colors, cell styles, ...) */
+	bool m_skipStyles;
+	/** the resource limits */
+	WPSParseLimits m_limits;
+	/** an optional callback used to follow the progression and to cancel the parsing (not owned) */
+	WPSParseCallback *m_callback;
+	/** an optional profile: if set, the time spent in each zone is measured and added to it (not owned) */
+	WPSParseProfile *m_profile;
+	/** the maximum number of threads which can be used to decode some independent zones in parallel
+		(currently the Quattro Pro 9 cell lists). A value of 0 or 1 means that the whole parsing is done
+		in the calling thread */
+	int m_numThreads;
+};
 
 /**
 This class provides all the functions an application would need to parse Works documents.
@@ -113,6 +259,26 @@ public:
 	*/
 	static WPSLIB WPSResult parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface,
 	                              char const *password="", char const *encoding="");
+	/**
+	   Parses the input stream content using some parsing options.
+	   \param input The input stream
+	   \param documentInterface A librevenge::RVNGTextInterface implementation
+	   \param options The parsing options
+	   \param password the file password
+	   \param encoding the encoding
+	*/
+	static WPSLIB WPSResult parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface,
+	                              WPSParseOptions const &options, char const *password="", char const *encoding="");
+	/**
+	   Parses the input stream content using some parsing options.
+	   \param input The input stream
+	   \param documentInterface A librevenge::RVNGSpreadsheetInterface implementation
+	   \param options The parsing options
+	   \param password the file password
+	   \param encoding the encoding
+	*/
+	static WPSLIB WPSResult parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface,
+	                              WPSParseOptions const &options, char const *password="", char const *encoding="");
 };
 
 } // namespace libwps
@@ -0,0 +1,894 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "BenchCorpus.h"
+
+namespace libwpsBench
+{
+namespace CorpusGeneratorInternal
+{
+//! a small deterministic random generator: a linear congruential generator
+class Random
+{
+public:
+	//! constructor
+	explicit Random(unsigned seed)
+		: m_state(seed ? seed : 1)
+	{
+	}
+	//! returns a value between 0 and max-1
+	int next(int max)
+	{
+		m_state = m_state*1103515245u+12345u;
+		if (max<=1) return 0;
+		return int(((m_state>>16)&0x7fff)%unsigned(max));
+	}
+	//! returns a value between 0 and 1
+	double nextDouble()
+	{
+		return double(next(0x8000))/double(0x8000);
+	}
+protected:
+	//! the state
+	uint32_t m_state;
+};
+
+//! a little endian writer
+class Output
+{
+public:
+	//! constructor
+	explicit Output(std::vector<unsigned char> &data)
+		: m_data(data)
+	{
+		m_data.clear();
+	}
+	//! returns the actual position
+	long tell() const
+	{
+		return long(m_data.size());
+	}
+	//! adds a byte
+	void put8(int val)
+	{
+		m_data.push_back(static_cast<unsigned char>(val&0xff));
+	}
+	//! adds a 16 bits value
+	void put16(int val)
+	{
+		put8(val);
+		put8(val>>8);
+	}
+	//! adds a 32 bits value
+	void put32(long val)
+	{
+		put16(int(val&0xffff));
+		put16(int((val>>16)&0xffff));
+	}
+	//! adds a IEEE double
+	void putDouble8(double val)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &val, 8);
+		for (int i=0; i<8; ++i, bits>>=8)
+			put8(int(bits&0xff));
+	}
+	//! adds a string and optionally a final 0
+	void putString(std::string const &str, bool addZero)
+	{
+		for (auto c : str) put8(int(static_cast<unsigned char>(c)));
+		if (addZero) put8(0);
+	}
+	//! adds n 0
+	void putZeros(long n)
+	{
+		m_data.resize(m_data.size()+size_t(n), 0);
+	}
+	//! adds 0 until the position is a multiple of modulo
+	void align(long modulo)
+	{
+		if (tell()%modulo)
+			putZeros(modulo-(tell()%modulo));
+	}
+	//! modifies a 16 bits value
+	void set16(long pos, int val)
+	{
+		m_data[size_t(pos)]=static_cast<unsigned char>(val&0xff);
+		m_data[size_t(pos)+1]=static_cast<unsigned char>((val>>8)&0xff);
+	}
+	//! modifies a 32 bits value
+	void set32(long pos, long val)
+	{
+		set16(pos, int(val&0xffff));
+		set16(pos+2, int((val>>16)&0xffff));
+	}
+protected:
+	//! the data
+	std::vector<unsigned char> &m_data;
+};
+
+//! returns a text of a given length made of random words
+static std::string getText(Random &random, int length)
+{
+	static char const *syllables[]=
+	{
+		"ba", "co", "de", "fu", "ga", "hi", "jo", "ka", "li", "mo", "nu", "pa",
+		"qui", "ro", "sa", "te", "vi", "wo", "xa", "ze", "lor", "ips", "dol", "met"
+	};
+	int const numSyllables=int(sizeof(syllables)/sizeof(syllables[0]));
+	std::string res;
+	while (int(res.size())<length)
+	{
+		if (!res.empty()) res+=' ';
+		int numS=1+random.next(3);
+		for (int s=0; s<numS; ++s)
+			res+=syllables[random.next(numSyllables)];
+	}
+	res.resize(size_t(std::max(length,0)));
+	if (!res.empty() && res.back()==' ') res.back()='x';
+	return res;
+}
+
+//! the cell's content type
+enum CellType { C_Text, C_Number, C_Formula };
+
+//! the spreadsheet's cells
+struct Cell
+{
+	//! constructor
+	Cell()
+		: m_type(C_Number)
+		, m_value(0)
+		, m_text()
+		, m_style(0)
+	{
+	}
+	//! the content type
+	CellType m_type;
+	//! the numeric value
+	double m_value;
+	//! the text
+	std::string m_text;
+	//! the style
+	int m_style;
+};
+
+/** a class used to create the cells: the first column contains some
+	text, the other columns contain numbers or formulas which compute
+	the sum of the previous cells of the row */
+class CellCreator
+{
+public:
+	//! constructor
+	CellCreator(CorpusGenerator::Parameters const &params, int maxTextLength=255)
+		: m_params(params)
+		, m_random(params.m_seed)
+		, m_maxTextLength(maxTextLength)
+	{
+	}
+	//! returns the next cell
+	Cell next(int col)
+	{
+		Cell cell;
+		cell.m_style=m_random.next(m_params.m_styles);
+		if (col==0)
+		{
+			cell.m_type=C_Text;
+			cell.m_text=getText(m_random, std::min(std::max(m_params.m_textLength,1), m_maxTextLength));
+			return cell;
+		}
+		if (m_random.nextDouble()<m_params.m_formulaDensity)
+			cell.m_type=C_Formula;
+		cell.m_value=double(m_random.next(1000000))/100.;
+		return cell;
+	}
+protected:
+	//! the parameters
+	CorpusGenerator::Parameters const &m_params;
+	//! the random generator
+	Random m_random;
+	//! the maximum text length
+	int m_maxTextLength;
+};
+
+////////////////////////////////////////////////////////////
+// spreadsheets
+////////////////////////////////////////////////////////////
+
+//! creates a Lotus 1-2-3 DOS or a Works DOS spreadsheet: .wk1 or .wks
+static bool createWKS(CorpusGenerator::Parameters const &params, bool lotus, std::vector<unsigned char> &data)
+{
+	int const numRows=std::min(params.m_rows, 0x2000), numCols=std::min(params.m_columns, 256);
+	if (numRows<=0 || numCols<=0) return false;
+	Output out(data);
+	out.put16(0); // BOF
+	out.put16(2);
+	out.put16(lotus ? 0x406 : 0x404);
+	if (!lotus)
+	{
+		// a database record followed by some data, which does not look like a record
+		out.put16(0x5464);
+		out.put16(4);
+		out.put32(8);
+		out.put16(0x2a);
+		out.put16(0xffff);
+		out.put32(0);
+	}
+	out.put16(6); // RANGE
+	out.put16(8);
+	out.put16(0);
+	out.put16(0);
+	out.put16(numCols-1);
+	out.put16(numRows-1);
+	CellCreator creator(params);
+	for (int r=0; r<numRows; ++r)
+	{
+		for (int c=0; c<numCols; ++c)
+		{
+			auto cell=creator.next(c);
+			int const type=cell.m_type==C_Text ? 0xf : cell.m_type==C_Number ? 0xe : 0x10;
+			int const dataSize=cell.m_type==C_Text ? int(cell.m_text.size())+2 : cell.m_type==C_Number ? 8 : 8+2+12;
+			out.put16(type);
+			out.put16(5+dataSize);
+			// format: the type and the number of digits
+			out.put8(cell.m_style==0 ? 0xff : ((((cell.m_style-1)%5)<<4) | (((cell.m_style-1)/5)&0xf)));
+			out.put8(c);
+			out.put8(0);
+			out.put16(r);
+			if (cell.m_type==C_Text)
+			{
+				out.put8('\'');
+				out.putString(cell.m_text, true);
+				continue;
+			}
+			out.putDouble8(cell.m_value);
+			if (cell.m_type==C_Number)
+				continue;
+			// Sum(A<r>:<c-1><r>)
+			out.put16(12);
+			out.put8(2);
+			out.put16(0);
+			out.put16(r);
+			out.put16(c-1);
+			out.put16(r);
+			out.put8(0x50);
+			out.put8(1);
+			out.put8(3);
+		}
+	}
+	out.put16(1); // EOF
+	out.put16(0);
+	return true;
+}
+
+//! creates a Quattro Pro DOS spreadsheet: .wq1
+static bool createWQ1(CorpusGenerator::Parameters const &params, std::vector<unsigned char> &data)
+{
+	int const numRows=std::min(params.m_rows, 0x2000), numCols=std::min(params.m_columns, 256);
+	if (numRows<=0 || numCols<=0) return false;
+	Output out(data);
+	out.put16(0); // BOF
+	out.put16(2);
+	out.put16(0x5120);
+	out.put16(6); // RANGE
+	out.put16(8);
+	out.put16(0);
+	out.put16(0);
+	out.put16(numCols-1);
+	out.put16(numRows-1);
+	CellCreator creator(params);
+	for (int r=0; r<numRows; ++r)
+	{
+		for (int c=0; c<numCols; ++c)
+		{
+			auto cell=creator.next(c);
+			int const type=cell.m_type==C_Text ? 0xf : cell.m_type==C_Number ? 0xe : 0x10;
+			int const dataSize=cell.m_type==C_Text ? int(cell.m_text.size())+2 : cell.m_type==C_Number ? 8 : 8+2+16;
+			out.put16(type);
+			out.put16(5+dataSize);
+			out.put8(cell.m_style==0 ? 0xff : ((((cell.m_style-1)%5)<<4) | (((cell.m_style-1)/5)&0xf)));
+			out.put8(c);
+			out.put8(0);
+			out.put16(r);
+			if (cell.m_type==C_Text)
+			{
+				// a pascal string
+				out.put8('\'');
+				out.put8(int(cell.m_text.size()));
+				out.putString(cell.m_text, false);
+				continue;
+			}
+			out.putDouble8(cell.m_value);
+			if (cell.m_type==C_Number)
+				continue;
+			// the code, then the list of cells, then the list of cell's ranges
+			out.put16(16);
+			out.put16(8);
+			out.put16(8);
+			out.put8(2);
+			out.put8(0x50);
+			out.put8(1);
+			out.put8(3);
+			out.put16(0);
+			out.put16(r);
+			out.put16(c-1);
+			out.put16(r);
+		}
+	}
+	out.put16(1); // EOF
+	out.put16(0);
+	return true;
+}
+
+//! creates a Quattro Pro spreadsheet: .wb1
+static bool createWB1(CorpusGenerator::Parameters const &params, std::vector<unsigned char> &data)
+{
+	int const numRows=std::min(params.m_rows, 0x2000), numCols=std::min(params.m_columns, 256);
+	int const numSheets=std::min(params.m_sheets, 256);
+	if (numRows<=0 || numCols<=0 || numSheets<=0) return false;
+	Output out(data);
+	out.put16(0); // BOF
+	out.put16(2);
+	out.put16(0x1001);
+	out.put16(6); // the dimension: min and max (column, sheet, row)
+	out.put16(8);
+	out.put32(0);
+	out.put8(numCols-1);
+	out.put8(numSheets-1);
+	out.put16(numRows-1);
+	CellCreator creator(params);
+	for (int s=0; s<numSheets; ++s)
+	{
+		out.put16(0xca); // begin of sheet
+		out.put16(1);
+		out.put8(s);
+		for (int r=0; r<numRows; ++r)
+		{
+			for (int c=0; c<numCols; ++c)
+			{
+				auto cell=creator.next(c);
+				int const type=cell.m_type==C_Text ? 0xf : cell.m_type==C_Number ? 0xe : 0x10;
+				int const dataSize=cell.m_type==C_Text ? int(cell.m_text.size())+2 : cell.m_type==C_Number ? 8 : 8+2+2+2+14;
+				out.put16(type);
+				out.put16(6+dataSize);
+				out.put8(c);
+				out.put8(s);
+				out.put16(r);
+				out.put16(0); // no style
+				if (cell.m_type==C_Text)
+				{
+					out.put8('\'');
+					out.putString(cell.m_text, true);
+					continue;
+				}
+				out.putDouble8(cell.m_value);
+				if (cell.m_type==C_Number)
+					continue;
+				out.put16(0); // state
+				// the code, then the list of cell's references
+				out.put16(14);
+				out.put16(4);
+				out.put8(2);
+				out.put8(0x50);
+				out.put8(1);
+				out.put8(3);
+				out.put16(0x1000);
+				out.put8(0);
+				out.put8(s);
+				out.put16(r);
+				out.put8(c-1);
+				out.put8(s);
+				out.put16(r);
+			}
+		}
+		out.put16(0xcb); // end of sheet
+		out.put16(1);
+		out.put8(s);
+	}
+	out.put16(1); // EOF
+	out.put16(0);
+	return true;
+}
+
+//! creates a Lotus 1-2-3 spreadsheet: .wk3 or .wk4
+static bool createWK3(CorpusGenerator::Parameters const &params, bool wk4, std::vector<unsigned char> &data)
+{
+	int const numRows=std::min(params.m_rows, 0x2000), numCols=std::min(params.m_columns, 256);
+	int const numSheets=std::min(params.m_sheets, 256);
+	if (numRows<=0 || numCols<=0 || numSheets<=0) return false;
+	Output out(data);
+	out.put16(0); // BOF
+	out.put16(26);
+	out.put16(wk4 ? 0x1002 : 0x1000);
+	out.putZeros(8);
+	out.put8(numSheets-1);
+	out.putZeros(15);
+	CellCreator creator(params);
+	for (int s=0; s<numSheets; ++s)
+	{
+		for (int r=0; r<numRows; ++r)
+		{
+			for (int c=0; c<numCols; ++c)
+			{
+				auto cell=creator.next(c);
+				int const type=cell.m_type==C_Text ? 0x16 : cell.m_type==C_Number ? 0x27 : 0x28;
+				int const dataSize=cell.m_type==C_Text ? int(cell.m_text.size())+2 : cell.m_type==C_Number ? 8 : 8+13;
+				out.put16(type);
+				out.put16(4+dataSize);
+				out.put16(r);
+				out.put8(s);
+				out.put8(c);
+				if (cell.m_type==C_Text)
+				{
+					out.put8('\'');
+					out.putString(cell.m_text, true);
+					continue;
+				}
+				out.putDouble8(cell.m_value);
+				if (cell.m_type==C_Number)
+					continue;
+				// Sum(A<r>:<c-1><r>)
+				out.put8(2);
+				out.put8(0);
+				out.put16(r);
+				out.put8(s);
+				out.put8(0);
+				out.put16(r);
+				out.put8(s);
+				out.put8(c-1);
+				out.put8(0x50);
+				out.put8(1);
+				out.put8(3);
+			}
+		}
+	}
+	out.put16(1); // EOF
+	out.put16(0);
+	return true;
+}
+
+//! writes a Multiplan v1 double: an exponent and 14 BCD digits
+static void putMultiplanDouble(Output &out, double value)
+{
+	int exponent=0;
+	int sign=value<0 ? 0x80 : 0;
+	value=std::fabs(value);
+	if (value>0)
+	{
+		exponent=int(std::floor(std::log10(value)))+1;
+		value/=std::pow(10., exponent);
+	}
+	out.put8(value>0 ? sign|(0x40+exponent) : 0);
+	for (int i=0; i<7; ++i)
+	{
+		int digits[2];
+		for (auto &d : digits)
+		{
+			value*=10;
+			d=std::min(std::max(int(value),0),9);
+			value-=d;
+		}
+		out.put8((digits[0]<<4)|digits[1]);
+	}
+}
+
+//! creates a Multiplan v1 spreadsheet
+static bool createMultiplan(CorpusGenerator::Parameters const &params, std::vector<unsigned char> &data)
+{
+	int const numRows=std::min(params.m_rows, 255), numCols=std::min(params.m_columns, 63);
+	if (numRows<=0 || numCols<=0) return false;
+	Output out(data);
+	out.put16(0xe708);
+	out.putZeros(0xfa-2); // the linked files' names
+	// zone B
+	out.put16(numRows);
+	out.put16(numCols);
+	out.putZeros(0x84-4);
+	out.putZeros(8*22); // zone C
+	for (int c=0; c<63; ++c) out.put8(10); // the columns' width
+	out.putZeros(29); // zone D
+	// the zone list: cell positions, links, files, cell data, shared data and names
+	long const cellPosSize=2*long(numRows)*long(numCols);
+	long const zonesListPos=out.tell();
+	out.putZeros(16);
+	long const cellPosBegin=out.tell();
+	out.putZeros(cellPosSize);
+	long const cellDataBegin=out.tell();
+	out.put16(0); // a cell position equal to 0 means no cell
+	CellCreator creator(params);
+	for (int r=0; r<numRows; ++r)
+	{
+		for (int c=0; c<numCols; ++c)
+		{
+			auto cell=creator.next(c);
+			// positions are stored as 16 bits values
+			long const cellPos=out.tell()-cellDataBegin;
+			if (cellPos+4+long(cell.m_text.size())+8>=0xffff)
+				break;
+			out.set16(cellPosBegin+2*(long(r)*numCols+c), int(cellPos));
+			// the formula size, the format, the content type and the data size
+			out.put8(0);
+			int const form=cell.m_style%7;
+			out.put8(((cell.m_style/7)&0xf)<<4 | (form<6 ? form : 7)<<1);
+			if (cell.m_type==C_Text)
+			{
+				out.put8(0x44);
+				out.put8(int(cell.m_text.size()));
+				out.putString(cell.m_text, false);
+			}
+			else
+			{
+				out.put8(0x04);
+				out.put8(8);
+				putMultiplanDouble(out, cell.m_value);
+			}
+		}
+	}
+	long const cellDataEnd=out.tell()-cellPosBegin;
+	if (cellDataEnd>0xffff) return false;
+	out.set16(zonesListPos, 0);
+	out.set16(zonesListPos+2, int(cellPosSize));
+	out.set16(zonesListPos+4, int(cellPosSize));
+	out.set16(zonesListPos+6, int(cellPosSize));
+	out.set16(zonesListPos+8, int(cellDataEnd-cellPosSize));
+	for (int i=5; i<8; ++i)
+		out.set16(zonesListPos+2*i, int(cellDataEnd));
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+// text documents
+////////////////////////////////////////////////////////////
+
+//! a paragraph: a text and a character style
+struct Paragraph
+{
+	//! constructor
+	Paragraph()
+		: m_text()
+		, m_style(0)
+	{
+	}
+	//! the text
+	std::string m_text;
+	//! the style
+	int m_style;
+};
+
+//! creates the list of paragraphs
+static std::vector<Paragraph> getParagraphs(CorpusGenerator::Parameters const &params)
+{
+	std::vector<Paragraph> res;
+	Random random(params.m_seed);
+	for (int p=0; p<params.m_rows; ++p)
+	{
+		Paragraph para;
+		para.m_text=getText(random, params.m_textLength);
+		para.m_style=random.next(params.m_styles);
+		res.push_back(para);
+	}
+	return res;
+}
+
+/** a class used to create a list of FOD pages: the pages used by
+	Works 2-4 and Write/Word for DOS to store the characters and the paragraphs'
+	properties */
+class FODPages
+{
+public:
+	//! constructor: works means Works's FDP, ie. the positions then the byte offsets, else Write's FDP
+	explicit FODPages(bool works)
+		: m_works(works)
+		, m_fodList()
+	{
+	}
+	//! adds a FOD: the text limit and the property, an empty property means the default property
+	void add(long lastPos, std::string const &property)
+	{
+		m_fodList.push_back(std::make_pair(lastPos, property));
+	}
+	//! writes the pages, returns the number of pages
+	int write(Output &out, long firstPos) const
+	{
+		int numPages=0;
+		size_t f=0;
+		while (f<m_fodList.size())
+		{
+			// find the fods which can be stored in the page
+			std::vector<std::string> properties;
+			size_t propSize=0, numFODs=0;
+			while (f+numFODs<m_fodList.size() && numFODs<(m_works ? 0x7f : 20))
+			{
+				auto const &prop=m_fodList[f+numFODs].second;
+				bool isNew=!prop.empty() && std::find(properties.begin(), properties.end(), prop)==properties.end();
+				size_t newPropSize=propSize+(isNew ? prop.size()+1 : 0);
+				if (getHeaderSize(numFODs+1)+newPropSize>=0x7f) break;
+				if (isNew) properties.push_back(prop);
+				propSize=newPropSize;
+				++numFODs;
+			}
+			if (numFODs==0) return numPages; // must not happen
+			std::vector<long> propPositions;
+			long pos=long(getHeaderSize(numFODs));
+			for (auto const &p : properties)
+			{
+				propPositions.push_back(pos);
+				pos+=long(p.size())+1;
+			}
+			auto getPosition=[&properties,&propPositions](std::string const &prop)
+			{
+				if (prop.empty()) return -1L;
+				auto it=std::find(properties.begin(), properties.end(), prop);
+				return propPositions[size_t(it-properties.begin())];
+			};
+			long const pageBegin=out.tell();
+			out.put32(firstPos);
+			if (m_works)
+			{
+				for (size_t i=0; i<numFODs; ++i) out.put32(m_fodList[f+i].first);
+				for (size_t i=0; i<numFODs; ++i)
+					out.put8(int(std::max(getPosition(m_fodList[f+i].second),0L)));
+			}
+			else
+			{
+				for (size_t i=0; i<numFODs; ++i)
+				{
+					out.put32(m_fodList[f+i].first);
+					long propPos=getPosition(m_fodList[f+i].second);
+					out.put16(propPos<0 ? 0xffff : int(propPos-4));
+				}
+			}
+			for (auto const &p : properties)
+			{
+				out.put8(int(p.size()));
+				out.putString(p, false);
+			}
+			out.putZeros(pageBegin+0x7f-out.tell());
+			out.put8(int(numFODs));
+			firstPos=m_fodList[f+numFODs-1].first;
+			f+=numFODs;
+			++numPages;
+		}
+		return numPages;
+	}
+protected:
+	//! returns the size of the page's header
+	size_t getHeaderSize(size_t numFODs) const
+	{
+		return m_works ? 4+5*numFODs : 4+6*numFODs;
+	}
+	//! a flag to know if we create Works or Write pages
+	bool m_works;
+	//! the list of text limit and property
+	std::vector<std::pair<long, std::string> > m_fodList;
+};
+
+//! returns the paragraphs' text and the text's limits
+static std::string getTextAndLimits(std::vector<Paragraph> const &paragraphs, long firstPos, std::vector<long> &limits)
+{
+	std::string text;
+	limits.clear();
+	for (auto const &para : paragraphs)
+	{
+		text+=para.m_text;
+		text+="\r\n";
+		limits.push_back(firstPos+long(text.size()));
+	}
+	return text;
+}
+
+//! creates a Works 3 text document: .wps
+static bool createWPS4(CorpusGenerator::Parameters const &params, std::vector<unsigned char> &data)
+{
+	if (params.m_rows<=0) return false;
+	auto paragraphs=getParagraphs(params);
+	std::vector<long> limits;
+	auto text=getTextAndLimits(paragraphs, 0x100, limits);
+	Output out(data);
+	out.putZeros(0x100);
+	out.putString(text, false);
+	long const textEnd=out.tell();
+	out.align(0x80);
+	// the characters' properties: the flags, the font id, the underline and the font size
+	FODPages chars(true), paras(true);
+	for (size_t p=0; p<paragraphs.size(); ++p)
+	{
+		int const style=paragraphs[p].m_style;
+		std::string prop;
+		if (style)
+			prop+=char(style&7);
+		if (style>=8)
+		{
+			prop+=char(0x18);
+			prop+=char((style/8)&1);
+			prop+=char(0);
+			prop+=char(2*(10+style/8));
+		}
+		chars.add(limits[p], prop);
+	}
+	paras.add(textEnd, "");
+	chars.write(out, 0x100);
+	paras.write(out, 0x100);
+	// the font names: the id, an unknown byte and a pascal string
+	long const fontPos=out.tell();
+	static char const *fontNames[]= {"Times New Roman", "Arial"};
+	for (int i=0; i<2; ++i)
+	{
+		out.put8(i);
+		out.put8(0);
+		out.put8(int(std::strlen(fontNames[i])));
+		out.putString(fontNames[i], false);
+	}
+	long const fontEnd=out.tell();
+	// the header
+	data[0]=4;
+	data[1]=0xfe;
+	out.set16(2, 0x4e27); // Works 3 for Windows
+	for (int i=0; i<3; ++i)
+		out.set32(0x1a + 4*i, 0x100);
+	out.set32(0x26, textEnd);
+	out.set32(0x2a, out.tell());
+	out.set32(0x5e, fontPos);
+	out.set16(0x62, int(fontEnd-fontPos));
+	// the page dimension: the margins, the length and the width
+	int const dims[]= {1440, 1440, 1800, 1800, 15840, 12240, 1};
+	for (int i=0; i<7; ++i)
+		out.set16(0x64+2*i, dims[i]);
+	return true;
+}
+
+//! creates a Write or a Word for DOS document: .wri or .doc
+static bool createWrite(CorpusGenerator::Parameters const &params, bool dosWord, std::vector<unsigned char> &data)
+{
+	if (params.m_rows<=0) return false;
+	auto paragraphs=getParagraphs(params);
+	std::vector<long> limits;
+	auto text=getTextAndLimits(paragraphs, 0x80, limits);
+	Output out(data);
+	out.putZeros(0x80);
+	out.putString(text, false);
+	long const textEnd=out.tell();
+	out.align(0x80);
+	// the characters' properties: a reserved byte, the bold/italic flags and the font size
+	FODPages chars(false), paras(false);
+	for (size_t p=0; p<paragraphs.size(); ++p)
+	{
+		int const style=paragraphs[p].m_style;
+		std::string prop;
+		if (style)
+		{
+			prop+=char(dosWord ? 0 : 1);
+			prop+=char(style&3);
+			prop+=char(24+2*(style/4));
+		}
+		chars.add(limits[p], prop);
+		paras.add(limits[p], "");
+	}
+	chars.write(out, 0x80);
+	long const pnPara=out.tell()/0x80;
+	paras.write(out, 0x80);
+	long const pnMac=out.tell()/0x80;
+	// the header
+	out.set16(0, 0xbe31);
+	out.set16(4, 0xab00);
+	out.set32(14, textEnd);
+	out.set16(18, int(pnPara));
+	out.set16(dosWord ? 106 : 96, int(pnMac));
+	return true;
+}
+
+//! creates a XYWrite DOS document
+static bool createXYWrite(CorpusGenerator::Parameters const &params, std::vector<unsigned char> &data)
+{
+	if (params.m_rows<=0) return false;
+	static char const *modes[]= {"NM", "BO", "RV", "UL", "BU", "BR", "DN", "SU" };
+	auto paragraphs=getParagraphs(params);
+	Output out(data);
+	// a format sequence is needed to recognize the document
+	out.putString("\xae" "MDNM" "\xaf", false);
+	for (auto const &para : paragraphs)
+	{
+		if (para.m_style)
+		{
+			out.putString(std::string("\xae" "MD")+modes[para.m_style%8]+"\xaf", false);
+			if (para.m_style>=8)
+				out.putString("\xae" "SZ"+std::to_string(10+para.m_style/8)+"PT\xaf", false);
+		}
+		out.putString(para.m_text, false);
+		if (para.m_style)
+			out.putString("\xae" "MDNM" "\xaf", false);
+		out.putString("\r\n", false);
+	}
+	out.put8(0x1a);
+	return true;
+}
+}
+
+////////////////////////////////////////////////////////////
+// main class
+////////////////////////////////////////////////////////////
+CorpusGenerator::CorpusGenerator(Parameters const &parameters)
+	: m_parameters(parameters)
+{
+	m_parameters.m_styles=std::max(m_parameters.m_styles, 1);
+	m_parameters.m_textLength=std::max(m_parameters.m_textLength, 1);
+	m_parameters.m_formulaDensity=std::min(std::max(m_parameters.m_formulaDensity, 0.), 1.);
+}
+
+bool CorpusGenerator::generate(Format format, std::vector<unsigned char> &data) const
+{
+	data.clear();
+	switch (format)
+	{
+	case WK1:
+	case WKS:
+		return CorpusGeneratorInternal::createWKS(m_parameters, format==WK1, data);
+	case WK3:
+	case WK4:
+		return CorpusGeneratorInternal::createWK3(m_parameters, format==WK4, data);
+	case WQ1:
+		return CorpusGeneratorInternal::createWQ1(m_parameters, data);
+	case WB1:
+		return CorpusGeneratorInternal::createWB1(m_parameters, data);
+	case Multiplan:
+		return CorpusGeneratorInternal::createMultiplan(m_parameters, data);
+	case WPS4:
+		return CorpusGeneratorInternal::createWPS4(m_parameters, data);
+	case MSWrite:
+	case DosWord:
+		return CorpusGeneratorInternal::createWrite(m_parameters, format==DosWord, data);
+	case XYWrite:
+		return CorpusGeneratorInternal::createXYWrite(m_parameters, data);
+	default:
+		break;
+	}
+	return false;
+}
+
+std::vector<CorpusGenerator::Format> CorpusGenerator::getFormats()
+{
+	return std::vector<Format> {WK1, WKS, WK3, WK4, WQ1, WB1, Multiplan, WPS4, MSWrite, DosWord, XYWrite};
+}
+
+bool CorpusGenerator::isSpreadsheet(Format format)
+{
+	return format!=WPS4 && format!=MSWrite && format!=DosWord && format!=XYWrite;
+}
+
+char const *CorpusGenerator::getName(Format format)
+{
+	static char const *names[]= {"wk1", "wks", "wk3", "wk4", "wq1", "wb1", "mp", "wps", "wri", "doc", "xy"};
+	return names[int(format)];
+}
+
+bool CorpusGenerator::getFormat(std::string const &name, Format &format)
+{
+	for (auto f : getFormats())
+	{
+		if (name!=getName(f)) continue;
+		format=f;
+		return true;
+	}
+	return false;
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
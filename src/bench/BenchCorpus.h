@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef BENCH_CORPUS_H
+#define BENCH_CORPUS_H
+
+#include <string>
+#include <vector>
+
+namespace libwpsBench
+{
+/** \brief a class used to create deterministic synthetic documents
+	which can be used to benchmark the parsers.
+
+	\note two generators created with the same parameters always
+	create the same documents.
+ */
+class CorpusGenerator
+{
+public:
+	//! the generated formats
+	enum Format { WK1, WKS, WK3, WK4, WQ1, WB1, Multiplan, WPS4, MSWrite, DosWord, XYWrite };
+	//! the generation parameters
+	struct Parameters
+	{
+		//! constructor
+		Parameters()
+			: m_rows(1000)
+			, m_columns(10)
+			, m_sheets(1)
+			, m_formulaDensity(0.2)
+			, m_textLength(40)
+			, m_styles(4)
+			, m_seed(1)
+		{
+		}
+		//! the number of rows in a spreadsheet, the number of paragraphs in a text document
+		int m_rows;
+		//! the number of columns in a spreadsheet
+		int m_columns;
+		//! the number of spreadsheets (in the formats which accept more than one spreadsheet)
+		int m_sheets;
+		//! the proportion of formula cells: between 0 and 1
+		double m_formulaDensity;
+		//! the length of the text cells, the length of the paragraphs in a text document
+		int m_textLength;
+		//! the number of different cell formats or character styles
+		int m_styles;
+		//! the random generator seed
+		unsigned m_seed;
+	};
+
+	//! constructor
+	explicit CorpusGenerator(Parameters const &parameters);
+	//! returns the parameters
+	Parameters const &parameters() const
+	{
+		return m_parameters;
+	}
+	/** creates a document in the given format, returns false if the
+		parameters can not be used with this format */
+	bool generate(Format format, std::vector<unsigned char> &data) const;
+
+	//! returns the list of formats
+	static std::vector<Format> getFormats();
+	//! returns true if the format is a spreadsheet format
+	static bool isSpreadsheet(Format format);
+	//! returns the format name, ie. the usual file extension
+	static char const *getName(Format format);
+	//! try to find a format from its name
+	static bool getFormat(std::string const &name, Format &format);
+
+protected:
+	//! the parameters
+	Parameters m_parameters;
+};
+}
+
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include "memoryCounter.h"
+
+#include "BenchMeasure.h"
+
+namespace libwpsBench
+{
+Measure::Measure()
+	: m_startTime(std::chrono::steady_clock::now())
+	, m_startClock(std::clock())
+	, m_startNumAllocations(getTotalNumAllocations())
+	, m_startAllocatedSize(getTotalAllocatedSize())
+	, m_wallTime(0)
+	, m_cpuTime(0)
+	, m_numAllocations(0)
+	, m_allocatedSize(0)
+{
+}
+
+void Measure::stop()
+{
+	std::chrono::duration<double> const elapsed=std::chrono::steady_clock::now()-m_startTime;
+	m_wallTime=elapsed.count();
+	m_cpuTime=double(std::clock()-m_startClock)/CLOCKS_PER_SEC;
+	m_numAllocations=getTotalNumAllocations()-m_startNumAllocations;
+	m_allocatedSize=getTotalAllocatedSize()-m_startAllocatedSize;
+}
+
+unsigned long Measure::getTotalNumAllocations()
+{
+	return libwpsHelper::getTotalNumAllocations();
+}
+
+unsigned long Measure::getTotalAllocatedSize()
+{
+	return libwpsHelper::getTotalAllocatedSize();
+}
+
+long Measure::getPeakRSS()
+{
+	return libwpsHelper::getPeakRSS();
+}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
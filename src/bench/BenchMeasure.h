@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef BENCH_MEASURE_H
+#define BENCH_MEASURE_H
+
+#include <chrono>
+#include <ctime>
+
+namespace libwpsBench
+{
+/** \brief a class used to measure a run: the wall time, the processor
+	time and the number of allocations.
+
+	\note the allocations are counted by the converters' memory counter,
+	which replaces the global operators new and delete, so all the
+	allocations done by the program, including the library's
+	allocations, are counted.
+ */
+class Measure
+{
+public:
+	//! constructor: starts the measure
+	Measure();
+	//! stops the measure
+	void stop();
+	//! returns the wall time in seconds
+	double wallTime() const
+	{
+		return m_wallTime;
+	}
+	//! returns the processor time in seconds
+	double cpuTime() const
+	{
+		return m_cpuTime;
+	}
+	//! returns the number of allocations
+	unsigned long numAllocations() const
+	{
+		return m_numAllocations;
+	}
+	//! returns the allocated size in bytes
+	unsigned long allocatedSize() const
+	{
+		return m_allocatedSize;
+	}
+
+	//! returns the total number of allocations since the program starts
+	static unsigned long getTotalNumAllocations();
+	//! returns the total allocated size since the program starts
+	static unsigned long getTotalAllocatedSize();
+	//! returns the peak resident set size in kilobytes or -1 if it is unknown
+	static long getPeakRSS();
+protected:
+	//! the wall time at the beginning
+	std::chrono::steady_clock::time_point m_startTime;
+	//! the processor time at the beginning
+	std::clock_t m_startClock;
+	//! the number of allocations at the beginning
+	unsigned long m_startNumAllocations;
+	//! the allocated size at the beginning
+	unsigned long m_startAllocatedSize;
+	//! the wall time
+	double m_wallTime;
+	//! the processor time
+	double m_cpuTime;
+	//! the number of allocations
+	unsigned long m_numAllocations;
+	//! the allocated size
+	unsigned long m_allocatedSize;
+};
+}
+
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
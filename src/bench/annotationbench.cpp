@@ -0,0 +1,182 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+/* a micro benchmark which measures the cost of the debug annotations in a
+   record loop: when they are written as in the parsers, ie. as arguments of
+   a DebugStream, and when they are guarded by WPS_DEBUG_ANNOTATE.
+
+   In a release build (DEBUG_WITH_FILES not defined), the guarded
+   annotations are not evaluated. */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "WPSDebug.h"
+
+#include "BenchMeasure.h"
+
+using namespace libwpsBench;
+
+namespace annotationbench
+{
+//! returns a name corresponding to the actual levels (similar to LotusParser's one)
+static std::string getLevelsDebugName(std::vector<Vec2i> const &levels)
+{
+	std::stringstream s;
+	for (size_t i=0; i<levels.size(); ++i)
+	{
+		auto const &level=levels[i];
+		if (i<4)
+		{
+			char const *wh[]= {"Z", "T", "C", "R"};
+			s << wh[i];
+		}
+		else
+			s << "[F" << i << "]";
+		if (level[0]==level[1])
+			s << "_";
+		else
+			s << level[0] << "x" << level[1]-1;
+	}
+	return s.str();
+}
+
+//! simulates a record loop where each record modifies a stack of levels
+static long recordLoop(int numRecords, bool guarded)
+{
+	std::vector<Vec2i> levels;
+	long checksum=0;
+	for (int r=0; r<numRecords; ++r)
+	{
+		libwps::DebugStream f;
+		f << "Entries(Zone1):";
+		switch (r%3)
+		{
+		case 0:
+			levels.push_back(Vec2i(r%5, r%7));
+			break;
+		case 1:
+			if (!levels.empty()) levels.back()[1]+=1;
+			break;
+		default:
+			if (levels.size()>4) levels.pop_back();
+			break;
+		}
+		if (guarded)
+			WPS_DEBUG_ANNOTATE(f << "[" << getLevelsDebugName(levels) << "],");
+		else
+			f << "[" << getLevelsDebugName(levels) << "],";
+		checksum+=long(levels.size());
+	}
+	return checksum;
+}
+
+//! simulates a formula loop where each formula creates a stream to store its error message
+static long formulaLoop(int numFormulas, bool debugStream)
+{
+	long checksum=0;
+	for (int r=0; r<numFormulas; ++r)
+	{
+		std::string error;
+		if (debugStream)
+		{
+			libwps::DebugStream f;
+			f << "###cell=" << r << ",";
+			error=f.str();
+		}
+		else
+		{
+			std::stringstream f;
+			f << "###cell=" << r << ",";
+			error=f.str();
+		}
+		checksum+=long(error.size())+r;
+	}
+	return checksum;
+}
+
+//! runs a test and prints the result
+static void printResult(char const *what, int num, Measure const &measure)
+{
+	printf("%-36s %10.2f %14.2f\n", what, 1e9*measure.wallTime()/num, double(measure.numAllocations())/num);
+}
+}
+
+static int printUsage()
+{
+	printf("`annotationbench' measures the cost of the debug annotations in a record loop.\n");
+	printf("\n");
+	printf("Usage: annotationbench [OPTION]\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("\t-h                 show this help message\n");
+	printf("\t-n NUM             the number of records (default 1000000)\n");
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	bool printHelp=false;
+	int ch;
+	int numRecords=1000000;
+
+	while ((ch = getopt(argc, argv, "hn:")) != -1)
+	{
+		switch (ch)
+		{
+		case 'n':
+			numRecords=std::atoi(optarg);
+			break;
+		default:
+		case 'h':
+			printHelp = true;
+			break;
+		}
+	}
+	if (numRecords<=0 || printHelp)
+	{
+		printUsage();
+		return -1;
+	}
+
+#if defined(DEBUG_WITH_FILES)
+	printf("the debug files are enabled: the guarded annotations are evaluated\n");
+#endif
+	printf("%-36s %10s %14s\n", "test", "ns/record", "allocs/record");
+	long checksum=0;
+	for (int guarded=0; guarded<2; ++guarded)
+	{
+		Measure measure;
+		checksum+=annotationbench::recordLoop(numRecords, guarded!=0);
+		measure.stop();
+		annotationbench::printResult(guarded ? "record loop: WPS_DEBUG_ANNOTATE" : "record loop: DebugStream arguments", numRecords, measure);
+	}
+	for (int debugStream=0; debugStream<2; ++debugStream)
+	{
+		Measure measure;
+		checksum+=annotationbench::formulaLoop(numRecords, debugStream!=0);
+		measure.stop();
+		annotationbench::printResult(debugStream ? "formula loop: DebugStream" : "formula loop: std::stringstream", numRecords, measure);
+	}
+	return checksum==0 ? 1 : 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
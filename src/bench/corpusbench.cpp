@@ -0,0 +1,234 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-generators/RVNGDummySpreadsheetGenerator.h>
+#include <librevenge-generators/RVNGDummyTextGenerator.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libwps/libwps.h>
+
+#include "BenchCorpus.h"
+#include "BenchMeasure.h"
+
+using namespace libwpsBench;
+
+namespace corpusbench
+{
+//! a dummy spreadsheet generator which counts the cells
+class SpreadsheetCounter final : public librevenge::RVNGDummySpreadsheetGenerator
+{
+public:
+	//! constructor
+	SpreadsheetCounter() : librevenge::RVNGDummySpreadsheetGenerator(), m_numCells(0) {}
+	//! open a cell
+	void openSheetCell(const librevenge::RVNGPropertyList &propList) override
+	{
+		++m_numCells;
+		librevenge::RVNGDummySpreadsheetGenerator::openSheetCell(propList);
+	}
+	//! the number of cells
+	long m_numCells;
+};
+
+//! a dummy text generator which counts the paragraphs
+class TextCounter final : public librevenge::RVNGDummyTextGenerator
+{
+public:
+	//! constructor
+	TextCounter() : librevenge::RVNGDummyTextGenerator(), m_numParagraphs(0) {}
+	//! open a paragraph
+	void openParagraph(const librevenge::RVNGPropertyList &propList) override
+	{
+		++m_numParagraphs;
+		librevenge::RVNGDummyTextGenerator::openParagraph(propList);
+	}
+	//! the number of paragraphs
+	long m_numParagraphs;
+};
+
+//! parses a generated document, returns the number of cells or paragraphs or -1
+static long parse(CorpusGenerator::Format format, std::vector<unsigned char> const &data)
+{
+	librevenge::RVNGStringStream input(data.data(), static_cast<unsigned int>(data.size()));
+	try
+	{
+		if (CorpusGenerator::isSpreadsheet(format))
+		{
+			SpreadsheetCounter generator;
+			if (libwps::WPSDocument::parse(&input, &generator)!=libwps::WPS_OK)
+				return -1;
+			return generator.m_numCells;
+		}
+		TextCounter generator;
+		if (libwps::WPSDocument::parse(&input, &generator)!=libwps::WPS_OK)
+			return -1;
+		return generator.m_numParagraphs;
+	}
+	catch (...)
+	{
+	}
+	return -1;
+}
+
+//! writes a generated document
+static bool writeFile(std::string const &fileName, std::vector<unsigned char> const &data)
+{
+	FILE *file=fopen(fileName.c_str(), "wb");
+	if (!file) return false;
+	bool ok=fwrite(data.data(), 1, data.size(), file)==data.size();
+	return fclose(file)==0 && ok;
+}
+}
+
+static int printUsage()
+{
+	printf("`corpusbench' creates synthetic documents and measures the time needed to parse\n");
+	printf("them with dummy generators. For each format, it reports the parsing speed in MB/s\n");
+	printf("and in cells/s (paragraphs/s for the text formats), the number of allocations per\n");
+	printf("parsing and the peak resident set size.\n");
+	printf("\n");
+	printf("Usage: corpusbench [OPTION] [FORMAT...]\n");
+	printf("\n");
+	printf("Formats: wk1, wks, wk3, wk4, wq1, wb1, mp, wps, wri, doc, xy (default: all)\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("\t-c NUM             the number of columns (default 10)\n");
+	printf("\t-f DENSITY         the proportion of formula cells (default 0.2)\n");
+	printf("\t-h                 show this help message\n");
+	printf("\t-n NUM             parse each document NUM times (default 5)\n");
+	printf("\t-o DIR             write the generated documents in DIR\n");
+	printf("\t-r NUM             the number of rows or paragraphs (default 1000)\n");
+	printf("\t-s NUM             the number of sheets (default 1)\n");
+	printf("\t-S SEED            the random generator seed (default 1)\n");
+	printf("\t-t NUM             the length of the texts (default 40)\n");
+	printf("\t-y NUM             the number of cell formats or character styles (default 4)\n");
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	bool printHelp=false;
+	int ch;
+	int numParsing=5;
+	char const *outputDir=nullptr;
+	CorpusGenerator::Parameters parameters;
+
+	while ((ch = getopt(argc, argv, "c:f:hn:o:r:s:S:t:y:")) != -1)
+	{
+		switch (ch)
+		{
+		case 'c':
+			parameters.m_columns=std::atoi(optarg);
+			break;
+		case 'f':
+			parameters.m_formulaDensity=std::atof(optarg);
+			break;
+		case 'n':
+			numParsing=std::atoi(optarg);
+			break;
+		case 'o':
+			outputDir=optarg;
+			break;
+		case 'r':
+			parameters.m_rows=std::atoi(optarg);
+			break;
+		case 's':
+			parameters.m_sheets=std::atoi(optarg);
+			break;
+		case 'S':
+			parameters.m_seed=unsigned(std::strtoul(optarg, nullptr, 10));
+			break;
+		case 't':
+			parameters.m_textLength=std::atoi(optarg);
+			break;
+		case 'y':
+			parameters.m_styles=std::atoi(optarg);
+			break;
+		default:
+		case 'h':
+			printHelp = true;
+			break;
+		}
+	}
+	if (numParsing<=0 || parameters.m_rows<=0 || parameters.m_columns<=0 || parameters.m_sheets<=0 || printHelp)
+	{
+		printUsage();
+		return -1;
+	}
+
+	std::vector<CorpusGenerator::Format> formats;
+	for (int f=optind; f<argc; ++f)
+	{
+		CorpusGenerator::Format format;
+		if (!CorpusGenerator::getFormat(argv[f], format))
+		{
+			fprintf(stderr, "ERROR: unknown format %s\n", argv[f]);
+			return 1;
+		}
+		formats.push_back(format);
+	}
+	if (formats.empty())
+		formats=CorpusGenerator::getFormats();
+
+	CorpusGenerator corpus(parameters);
+	bool ok=true;
+	printf("%-6s %10s %10s %8s %12s %12s %12s %10s\n", "format", "size", "cells", "time(ms)", "MB/s", "cells/s", "allocs/run", "RSS(kB)");
+	for (auto format : formats)
+	{
+		std::vector<unsigned char> data;
+		if (!corpus.generate(format, data))
+		{
+			fprintf(stderr, "ERROR: can not create a %s document\n", CorpusGenerator::getName(format));
+			ok=false;
+			continue;
+		}
+		if (outputDir)
+		{
+			std::string fileName=std::string(outputDir)+"/corpus."+CorpusGenerator::getName(format);
+			if (!corpusbench::writeFile(fileName, data))
+				fprintf(stderr, "ERROR: can not write %s\n", fileName.c_str());
+		}
+		// a first parsing to check that the document is read
+		long numCells=corpusbench::parse(format, data);
+		if (numCells<0)
+		{
+			fprintf(stderr, "ERROR: can not parse the %s document\n", CorpusGenerator::getName(format));
+			ok=false;
+			continue;
+		}
+		Measure measure;
+		for (int i=0; i<numParsing; ++i)
+			corpusbench::parse(format, data);
+		measure.stop();
+		double const time=measure.wallTime()/numParsing;
+		double const mbPerSec=time>0 ? double(data.size())/time/(1024.*1024.) : 0;
+		double const cellsPerSec=time>0 ? double(numCells)/time : 0;
+		printf("%-6s %10lu %10ld %8.2f %12.2f %12.0f %12lu %10ld\n", CorpusGenerator::getName(format),
+		       static_cast<unsigned long>(data.size()), numCells, 1000*time, mbPerSec, cellsPerSec,
+		       measure.numAllocations()/static_cast<unsigned long>(numParsing), Measure::getPeakRSS());
+	}
+	return ok ? 0 : 1;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,642 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+/* a micro benchmark of the functions which decode the legacy floating
+   point formats (libwps::readDouble4, readDouble8, ...).
+
+   It first checks that the functions return exactly the same results
+   as the original stream-based implementations (kept here as
+   reference) on random and on edge byte patterns, then it measures
+   the time needed to decode a value with the reference functions,
+   with the current stream functions, with the buffer functions and,
+   when they exist, with the list functions. */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "libwps_internal.h"
+
+#include "BenchMeasure.h"
+
+using namespace libwpsBench;
+
+namespace doublebench
+{
+////////////////////////////////////////////////////////////
+// the original implementations
+////////////////////////////////////////////////////////////
+
+//! the original readDouble4
+static bool refDouble4(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	long pos = input->tell();
+	if (input->seek(4, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+4)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	input->seek(pos, librevenge::RVNG_SEEK_SET);
+
+	double mantisse = 0;
+	auto first = int(libwps::readU8(input));
+	if ((first&3)==2)
+	{
+		input->seek(-1, librevenge::RVNG_SEEK_CUR);
+		auto val=long(libwps::readU16(input)>>2);
+		val+=long(libwps::readU16(input))<<14;
+		if (val&0x20000000)
+			res = double(val-0x40000000);
+		else
+			res = double(val);
+		return true;
+	}
+	mantisse = double(first & 0xFC)/256 + double(libwps::readU8(input));
+	auto mantExp = int(libwps::readU8(input));
+	mantisse = (mantisse/256 + double(0x10+(mantExp & 0x0F)))/16;
+	int exp = ((mantExp&0xF0)>>4)+int(libwps::readU8(input)<<4);
+	int sign = 1;
+	if (exp & 0x800)
+	{
+		exp &= 0x7ff;
+		sign = -1;
+	}
+
+	if (exp == 0)
+	{
+		if (double(mantisse) > 1.-1e-4)  return true;
+		return false;
+	}
+	if (exp == 0x7FF)
+	{
+		if (double(mantisse) > 1.-1e-4)
+		{
+			res=std::numeric_limits<double>::quiet_NaN();
+			isNaN=true;
+			return true;
+		}
+		return false;
+	}
+
+	exp -= 0x3ff;
+	res = std::ldexp(mantisse, exp);
+	if (sign == -1)
+	{
+		res *= -1.;
+	}
+	if (first & 1) res/=100;
+	return true;
+}
+
+//! the original readDouble8
+static bool refDouble8(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	long pos = input->tell();
+	if (input->seek(8, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+8)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	input->seek(pos, librevenge::RVNG_SEEK_SET);
+	double mantisse = 0;
+	for (int i = 0; i < 6; i++)
+		mantisse = mantisse/256 + double(libwps::readU8(input));
+	auto mantExp = int(libwps::readU8(input));
+	mantisse = (mantisse/256 + double(0x10+(mantExp & 0x0F)))/16;
+	int exp = ((mantExp&0xF0)>>4)+int(libwps::readU8(input)<<4);
+	int sign = 1;
+	if (exp & 0x800)
+	{
+		exp &= 0x7ff;
+		sign = -1;
+	}
+
+	double const epsilon=1.e-5;
+	if (exp == 0)
+	{
+		if (mantisse > 1-epsilon && mantisse < 1+epsilon)  return true;
+		return false;
+	}
+	if (exp == 0x7FF)
+	{
+		if (mantisse >= 1-epsilon)
+		{
+			res=std::numeric_limits<double>::quiet_NaN();
+			return true;
+		}
+		return false;
+	}
+
+	exp -= 0x3ff;
+	res = std::ldexp(mantisse, exp);
+	if (sign == -1)
+	{
+		res *= -1.;
+	}
+	return true;
+}
+
+//! the original readDouble10
+static bool refDouble10(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	long pos = input->tell();
+	if (input->seek(10, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+10)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	input->seek(pos, librevenge::RVNG_SEEK_SET);
+	double mantisse = 0;
+	for (int i = 0; i < 8; i++)
+		mantisse = mantisse/256 + double(libwps::readU8(input))/128;
+	auto exp = int(libwps::readU16(input));
+	int sign = 1;
+	if (exp & 0x8000)
+	{
+		exp &= 0x7fff;
+		sign = -1;
+	}
+
+	double const epsilon=1.e-5;
+	if (exp == 0)
+	{
+		if (mantisse < epsilon)  return true;
+		return false;
+	}
+	if (exp == 0x7FFf)
+	{
+		if (mantisse >= 1-epsilon)
+		{
+			res=std::numeric_limits<double>::quiet_NaN();
+			return true;
+		}
+		return false;
+	}
+
+	exp -= 0x3fff;
+	res = std::ldexp(mantisse, exp);
+	if (sign == -1)
+	{
+		res *= -1.;
+	}
+	return true;
+}
+
+//! the original readDouble2Inv
+static bool refDouble2Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	long pos = input->tell();
+	if (input->seek(2, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+2)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	input->seek(pos, librevenge::RVNG_SEEK_SET);
+	auto val=int(libwps::readU16(input));
+	int exp=val&0xf;
+	if ((exp&1)==1)
+	{
+		int mantisse=(val>>4);
+		if ((mantisse&0x800))
+			mantisse -= 0x1000;
+		exp/=2;
+		const double factors[8]= { 5000, 500, 0.05, 0.005, 0.0005, 0.00005, 1/16., 1/64. };
+		res=double(mantisse)*factors[exp];
+		return true;
+	}
+	if ((val&0x8000))
+		val-=0x10000;
+	res=double(val>>1);
+	return true;
+}
+
+//! the original readDouble4Inv
+static bool refDouble4Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	long pos = input->tell();
+	if (input->seek(4, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+4)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	input->seek(pos, librevenge::RVNG_SEEK_SET);
+	auto val=long(libwps::readU32(input));
+	auto exp=int(val&0xf);
+	auto mantisse=int(val>>6);
+	if (val&0x20)
+		mantisse *= -1;
+	if (exp)
+	{
+		if (val&0x10)
+			res=mantisse/std::pow(10., exp);
+		else
+			res=mantisse*std::pow(10., exp);
+		return true;
+	}
+	res=double(mantisse);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+// the decoders
+////////////////////////////////////////////////////////////
+
+//! a function which reads a double in a stream
+typedef bool (*StreamFunction)(RVNGInputStreamPtr &input, double &res, bool &isNaN);
+//! a function which decodes a double from a buffer
+typedef bool (*BufferFunction)(unsigned char const *data, double &res, bool &isNaN);
+//! a function which reads a list of doubles in a stream
+typedef bool (*ListFunction)(RVNGInputStreamPtr &input, size_t num, std::vector<double> &res);
+
+//! a decoder: its size and its implementations
+struct Decoder
+{
+	//! the decoder name
+	char const *m_name;
+	//! the number of bytes of a value
+	int m_size;
+	//! the original implementation
+	StreamFunction m_reference;
+	//! the stream implementation
+	StreamFunction m_stream;
+	//! the buffer implementation
+	BufferFunction m_buffer;
+	//! the list implementation (if it exists)
+	ListFunction m_list;
+};
+
+static Decoder const s_decoders[]=
+{
+	{"readDouble4", 4, &refDouble4, &libwps::readDouble4, &libwps::readDouble4, &libwps::readDouble4List},
+	{"readDouble8", 8, &refDouble8, &libwps::readDouble8, &libwps::readDouble8, &libwps::readDouble8List},
+	{"readDouble10", 10, &refDouble10, &libwps::readDouble10, &libwps::readDouble10, nullptr},
+	{"readDouble2Inv", 2, &refDouble2Inv, &libwps::readDouble2Inv, &libwps::readDouble2Inv, nullptr},
+	{"readDouble4Inv", 4, &refDouble4Inv, &libwps::readDouble4Inv, &libwps::readDouble4Inv, nullptr}
+};
+
+////////////////////////////////////////////////////////////
+// the patterns
+////////////////////////////////////////////////////////////
+
+/** creates a pattern for a decoder: random bytes where the exponent
+	and the lowest bits are often replaced by some edge values */
+static void createPattern(Decoder const &decoder, std::mt19937 &gen, unsigned char *data)
+{
+	for (int i=0; i<decoder.m_size; ++i)
+		data[i]=static_cast<unsigned char>(gen()&0xff);
+	unsigned const choice=gen()%8;
+	int const size=decoder.m_size;
+	if (size==4 && decoder.m_reference==&refDouble4)
+	{
+		// the case (first&3)==3 is signaled in a debug build, so it is only checked in the edge patterns
+		if ((data[0]&3)==3) data[0]&=0xfe;
+		if (choice<3)   // exponent 0 or 0x7ff
+		{
+			int const exp=choice==0 ? 0 : 0x7ff;
+			data[2]=static_cast<unsigned char>((data[2]&0xf)|((exp&0xf)<<4));
+			data[3]=static_cast<unsigned char>((data[3]&0x80)|(exp>>4));
+		}
+	}
+	else if (size==8)
+	{
+		if (choice<3)   // exponent 0 or 0x7ff, mantisse often small
+		{
+			int const exp=choice==0 ? 0 : 0x7ff;
+			data[6]=static_cast<unsigned char>((data[6]&0xf)|((exp&0xf)<<4));
+			data[7]=static_cast<unsigned char>((data[7]&0x80)|(exp>>4));
+			if (choice!=2)
+			{
+				data[6]&=0xf0;
+				for (int i=5; i>=2; --i) data[i]=0;
+			}
+		}
+	}
+	else if (size==10)
+	{
+		if (choice<4)   // a number converted from a binary64
+		{
+			data[7]|=0x80;
+			data[0]=0;
+			data[1]&=0xf8;
+			if (choice<2)   // near the limits of the binary64 range
+			{
+				int exp=0x3fff+(choice==0 ? -1022 : 1023)+int(gen()%5)-2;
+				data[8]=static_cast<unsigned char>(exp&0xff);
+				data[9]=static_cast<unsigned char>((data[9]&0x80)|(exp>>8));
+			}
+			else
+			{
+				int exp=0x3fff+int(gen()%200)-100;
+				data[8]=static_cast<unsigned char>(exp&0xff);
+				data[9]=static_cast<unsigned char>((data[9]&0x80)|(exp>>8));
+			}
+		}
+		else if (choice<6)   // exponent 0 or 0x7fff
+		{
+			int const exp=choice==4 ? 0 : 0x7fff;
+			data[8]=static_cast<unsigned char>(exp&0xff);
+			data[9]=static_cast<unsigned char>((data[9]&0x80)|(exp>>8));
+			if (gen()&1)
+			{
+				for (int i=0; i<7; ++i) data[i]=0;
+				data[7]=(choice==4) ? 0 : 0x80;
+			}
+		}
+		else if (choice==6)   // a not normalized mantisse
+			data[7]&=0x7f;
+	}
+}
+
+//! returns a list of edge patterns for a decoder
+static std::vector<std::vector<unsigned char> > getEdgePatterns(Decoder const &decoder)
+{
+	std::vector<std::vector<unsigned char> > res;
+	auto const size=size_t(decoder.m_size);
+	unsigned char const values[]= {0, 1, 2, 3, 0x7f, 0x80, 0xf0, 0xfc, 0xfe, 0xff};
+	// all the patterns where the first byte and the last two bytes take one of the previous values
+	for (auto v0 : values)
+	{
+		for (auto v1 : values)
+		{
+			for (auto v2 : values)
+			{
+				std::vector<unsigned char> pattern(size, 0);
+				pattern[0]=v0;
+				pattern[size-2]=v1;
+				pattern[size-1]=v2;
+				res.push_back(pattern);
+				std::vector<unsigned char> full(size, 0xff);
+				full[0]=v0;
+				full[size-2]=v1;
+				full[size-1]=v2;
+				res.push_back(full);
+			}
+		}
+	}
+	return res;
+}
+
+////////////////////////////////////////////////////////////
+// the checks and the measures
+////////////////////////////////////////////////////////////
+
+//! returns true if the two results are identical
+static bool isSame(bool ok1, double res1, bool nan1, bool ok2, double res2, bool nan2)
+{
+	if (ok1!=ok2 || nan1!=nan2) return false;
+	if (std::isnan(res1) || std::isnan(res2)) return std::isnan(res1) && std::isnan(res2);
+	return std::memcmp(&res1, &res2, sizeof(double))==0;
+}
+
+//! checks a pattern, returns false if the results differ
+static bool checkPattern(Decoder const &decoder, unsigned char const *data)
+{
+	auto const size=static_cast<unsigned int>(decoder.m_size);
+	// a stream with the value followed by some data
+	std::vector<unsigned char> buffer(data, data+size);
+	buffer.resize(size+3, 0x55);
+	RVNGInputStreamPtr input(new librevenge::RVNGStringStream(buffer.data(), static_cast<unsigned int>(buffer.size())));
+
+	double res1, res2, res3;
+	bool nan1, nan2, nan3;
+	bool ok1=decoder.m_reference(input, res1, nan1);
+	long pos1=input->tell();
+	input->seek(0, librevenge::RVNG_SEEK_SET);
+	bool ok2=decoder.m_stream(input, res2, nan2);
+	long pos2=input->tell();
+	bool ok3=decoder.m_buffer(data, res3, nan3);
+	if (pos1!=pos2 || !isSame(ok1, res1, nan1, ok2, res2, nan2) || !isSame(ok1, res1, nan1, ok3, res3, nan3))
+	{
+		printf("%s: find a difference for", decoder.m_name);
+		for (unsigned int i=0; i<size; ++i) printf(" %02x", data[i]);
+		printf(": %d,%.17g,%d[%ld] %d,%.17g,%d[%ld] %d,%.17g,%d\n", int(ok1), res1, int(nan1), pos1,
+		       int(ok2), res2, int(nan2), pos2, int(ok3), res3, int(nan3));
+		return false;
+	}
+	return true;
+}
+
+//! checks that the functions do not read a too short zone
+static bool checkShortZone(Decoder const &decoder)
+{
+	std::vector<unsigned char> buffer(size_t(decoder.m_size+1), 0x10);
+	RVNGInputStreamPtr input(new librevenge::RVNGStringStream(buffer.data(), static_cast<unsigned int>(buffer.size())));
+	input->seek(2, librevenge::RVNG_SEEK_SET);
+	double res1, res2;
+	bool nan1, nan2;
+	bool ok1=decoder.m_reference(input, res1, nan1);
+	long pos1=input->tell();
+	bool ok2=decoder.m_stream(input, res2, nan2);
+	long pos2=input->tell();
+	if (pos1!=2 || pos2!=2 || !isSame(ok1, res1, nan1, ok2, res2, nan2))
+	{
+		printf("%s: find a difference for a too short zone\n", decoder.m_name);
+		return false;
+	}
+	if (decoder.m_list)
+	{
+		std::vector<double> values;
+		input->seek(0, librevenge::RVNG_SEEK_SET);
+		if (decoder.m_list(input, 2, values) || !values.empty() || input->tell()!=0)
+		{
+			printf("%s: the list function accepts a too short zone\n", decoder.m_name);
+			return false;
+		}
+	}
+	return true;
+}
+
+//! checks a decoder on numPatterns random patterns and on the edge patterns, returns the number of differences
+static long checkDecoder(Decoder const &decoder, long numPatterns, std::mt19937 &gen)
+{
+	long numDiffs=0;
+	std::vector<unsigned char> pattern(size_t(decoder.m_size));
+	for (long i=0; i<numPatterns; ++i)
+	{
+		createPattern(decoder, gen, pattern.data());
+		if (!checkPattern(decoder, pattern.data()) && ++numDiffs>10)
+			return numDiffs;
+	}
+	for (auto const &edge : getEdgePatterns(decoder))
+	{
+		if (!checkPattern(decoder, edge.data()) && ++numDiffs>10)
+			return numDiffs;
+	}
+	if (!checkShortZone(decoder)) ++numDiffs;
+	return numDiffs;
+}
+
+//! the different ways to decode the values
+enum Method { M_Reference, M_Stream, M_Buffer, M_List };
+
+//! decodes numValues stored in data with a method, returns a checksum
+static double decodeAll(Decoder const &decoder, Method method, std::vector<unsigned char> const &data, size_t numValues)
+{
+	double checksum=0, res;
+	bool isNaN;
+	if (method==M_Buffer)
+	{
+		unsigned char const *ptr=data.data();
+		for (size_t i=0; i<numValues; ++i, ptr+=decoder.m_size)
+		{
+			if (decoder.m_buffer(ptr, res, isNaN) && !std::isnan(res)) checksum+=res;
+		}
+		return checksum;
+	}
+	RVNGInputStreamPtr input(new librevenge::RVNGStringStream(data.data(), static_cast<unsigned int>(data.size())));
+	if (method==M_List)
+	{
+		std::vector<double> values;
+		values.reserve(numValues);
+		if (decoder.m_list(input, numValues, values))
+		{
+			for (auto const &value : values)
+				if (!std::isnan(value)) checksum+=value;
+		}
+		return checksum;
+	}
+	StreamFunction function=method==M_Reference ? decoder.m_reference : decoder.m_stream;
+	for (size_t i=0; i<numValues; ++i)
+	{
+		if (function(input, res, isNaN) && !std::isnan(res)) checksum+=res;
+	}
+	return checksum;
+}
+
+//! measures the time needed to decode a value with a method, returns the time in nanoseconds
+static double measure(Decoder const &decoder, Method method, std::vector<unsigned char> const &data, size_t numValues, int numRuns, double &checksum)
+{
+	Measure measure;
+	for (int run=0; run<numRuns; ++run)
+		checksum+=decodeAll(decoder, method, data, numValues);
+	measure.stop();
+	return 1e9*measure.wallTime()/double(numValues)/numRuns;
+}
+}
+
+static int printUsage()
+{
+	printf("`doublebench' checks and measures the functions which decode the legacy floating point formats.\n");
+	printf("\n");
+	printf("Usage: doublebench [OPTION]\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("\t-c                 only check the functions\n");
+	printf("\t-h                 show this help message\n");
+	printf("\t-n NUM             the number of random patterns to check (default 1000000)\n");
+	printf("\t-r NUM             the number of runs (default 10)\n");
+	printf("\t-s NUM             the random seed (default 0)\n");
+	printf("\t-v NUM             the number of values decoded in a run (default 100000)\n");
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	using namespace doublebench;
+	bool printHelp=false, onlyCheck=false;
+	int ch;
+	long numPatterns=1000000, numValues=100000;
+	int numRuns=10;
+	unsigned seed=0;
+
+	while ((ch = getopt(argc, argv, "chn:r:s:v:")) != -1)
+	{
+		switch (ch)
+		{
+		case 'c':
+			onlyCheck=true;
+			break;
+		case 'n':
+			numPatterns=std::atol(optarg);
+			break;
+		case 'r':
+			numRuns=std::atoi(optarg);
+			break;
+		case 's':
+			seed=unsigned(std::atol(optarg));
+			break;
+		case 'v':
+			numValues=std::atol(optarg);
+			break;
+		default:
+		case 'h':
+			printHelp = true;
+			break;
+		}
+	}
+	if (numPatterns<0 || numRuns<=0 || numValues<=0 || printHelp)
+	{
+		printUsage();
+		return -1;
+	}
+
+	std::mt19937 gen(seed);
+	long numDiffs=0;
+	printf("%-16s %12s %12s\n", "decoder", "patterns", "differences");
+	for (auto const &decoder : s_decoders)
+	{
+		long diffs=checkDecoder(decoder, numPatterns, gen);
+		printf("%-16s %12ld %12ld\n", decoder.m_name, numPatterns, diffs);
+		numDiffs+=diffs;
+	}
+	if (numDiffs)
+	{
+		printf("the functions are not equivalent\n");
+		return 1;
+	}
+	if (onlyCheck) return 0;
+
+	printf("\n%-16s %12s %12s %12s %12s\n", "decoder", "original", "stream", "buffer", "list");
+	double checksum=0;
+	for (auto const &decoder : s_decoders)
+	{
+		std::vector<unsigned char> data(size_t(numValues)*size_t(decoder.m_size));
+		for (size_t i=0; i<size_t(numValues); ++i)
+			createPattern(decoder, gen, &data[i*size_t(decoder.m_size)]);
+		printf("%-16s", decoder.m_name);
+		for (int m=M_Reference; m<=M_List; ++m)
+		{
+			if (m==M_List && !decoder.m_list)
+			{
+				printf(" %12s", "-");
+				continue;
+			}
+			printf(" %9.2f ns", measure(decoder, Method(m), data, size_t(numValues), numRuns, checksum));
+		}
+		printf("\n");
+	}
+	return std::isnan(checksum) ? 1 : 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
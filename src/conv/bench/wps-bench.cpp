@@ -0,0 +1,416 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-generators/librevenge-generators.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libwps/libwps.h>
+
+#include "helper.h"
+#include "memoryCounter.h"
+#include "traceStream.h"
+
+using namespace libwps;
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifndef VERSION
+#define VERSION "UNKNOWN VERSION"
+#endif
+
+namespace wpsBench
+{
+//! the benchmarked phases
+enum Mode { M_Detect, M_Parse, M_Emit };
+
+//! the result of the benchmark of a file
+struct Result
+{
+	//! constructor
+	explicit Result(std::string const &file)
+		: m_file(file)
+		, m_size(0)
+		, m_numRuns(0)
+		, m_wallTime(0)
+		, m_cpuTime(0)
+		, m_numAllocations(0)
+		, m_allocatedSize(0)
+		, m_peakRSS(-1)
+		, m_error()
+		, m_tracer()
+	{
+	}
+	//! the file name
+	std::string m_file;
+	//! the file size
+	long m_size;
+	//! the number of runs
+	int m_numRuns;
+	//! the total wall time in seconds
+	double m_wallTime;
+	//! the total processor time in seconds
+	double m_cpuTime;
+	//! the total number of allocations
+	unsigned long m_numAllocations;
+	//! the total allocated size
+	unsigned long m_allocatedSize;
+	//! the peak resident set size in kilobytes after the runs
+	long m_peakRSS;
+	//! the error message if the file can not be read
+	std::string m_error;
+	//! the accesses made to the file during a traced run (if asked)
+	std::shared_ptr<libwpsHelper::Tracer> m_tracer;
+};
+
+//! does one run: detects the format and parses the file (if needed)
+static WPSResult run(librevenge::RVNGInputStream &input, Mode mode, char const *password, char const *encoding)
+{
+	input.seek(0, librevenge::RVNG_SEEK_SET);
+	WPSKind kind;
+	WPSCreator creator;
+	bool needCharEncoding;
+	if (WPSDocument::isFileFormatSupported(&input, kind, creator, needCharEncoding)==WPS_CONFIDENCE_NONE)
+		return WPS_UNKNOWN_ERROR;
+	if (mode==M_Detect)
+		return WPS_OK;
+	input.seek(0, librevenge::RVNG_SEEK_SET);
+	if (kind==WPS_TEXT)
+	{
+		if (mode==M_Parse)
+		{
+			librevenge::RVNGDummyTextGenerator listenerImpl;
+			return WPSDocument::parse(&input, &listenerImpl, password, encoding);
+		}
+		librevenge::RVNGString document;
+		librevenge::RVNGTextTextGenerator listenerImpl(document);
+		return WPSDocument::parse(&input, &listenerImpl, password, encoding);
+	}
+	if (mode==M_Parse)
+	{
+		librevenge::RVNGDummySpreadsheetGenerator listenerImpl;
+		return WPSDocument::parse(&input, &listenerImpl, password, encoding);
+	}
+	librevenge::RVNGStringVector document;
+	librevenge::RVNGTextSpreadsheetGenerator listenerImpl(document);
+	return WPSDocument::parse(&input, &listenerImpl, password, encoding);
+}
+
+//! benchmarks a file, if trace is set, does a last run which registers the accesses to the file
+static Result benchFile(std::string const &file, int numRuns, Mode mode, char const *password, char const *encoding, bool trace)
+{
+	Result res(file);
+	WPSConfidence confidence;
+	WPSKind kind;
+	bool needCharEncoding;
+	auto input=libwpsHelper::isSupported(file.c_str(), confidence, kind, needCharEncoding);
+	if (!input || confidence == WPS_CONFIDENCE_NONE)
+	{
+		res.m_error="unsupported file format";
+		return res;
+	}
+	input->seek(0, librevenge::RVNG_SEEK_END);
+	res.m_size=input->tell();
+
+	auto const startTime=std::chrono::steady_clock::now();
+	std::clock_t const startClock=std::clock();
+	unsigned long const startNumAllocations=libwpsHelper::getTotalNumAllocations();
+	unsigned long const startAllocatedSize=libwpsHelper::getTotalAllocatedSize();
+	for (int i=0; i<numRuns; ++i)
+	{
+		WPSResult error=WPS_UNKNOWN_ERROR;
+		try
+		{
+			error=run(*input, mode, password, encoding);
+		}
+		catch (...)
+		{
+		}
+		if (error!=WPS_OK)
+		{
+			res.m_error=error==WPS_UNKNOWN_ERROR ? "unknown error" : "parse error";
+			break;
+		}
+		++res.m_numRuns;
+	}
+	std::chrono::duration<double> const elapsed=std::chrono::steady_clock::now()-startTime;
+	res.m_wallTime=elapsed.count();
+	res.m_cpuTime=double(std::clock()-startClock)/CLOCKS_PER_SEC;
+	res.m_numAllocations=libwpsHelper::getTotalNumAllocations()-startNumAllocations;
+	res.m_allocatedSize=libwpsHelper::getTotalAllocatedSize()-startAllocatedSize;
+	res.m_peakRSS=libwpsHelper::getPeakRSS();
+	if (!trace || res.m_numRuns!=numRuns)
+		return res;
+
+	res.m_tracer.reset(new libwpsHelper::Tracer);
+	libwpsHelper::TraceStream traceInput(input, res.m_tracer);
+	try
+	{
+		run(traceInput, mode, password, encoding);
+	}
+	catch (...)
+	{
+	}
+	return res;
+}
+
+//! adds a file or the files of a directory in the list of files
+static void addFiles(std::string const &path, std::vector<std::string> &files)
+{
+	struct stat status;
+	if (stat(path.c_str(), &status)!=0)
+	{
+		fprintf(stderr, "ERROR: can not find %s\n", path.c_str());
+		return;
+	}
+	if (!S_ISDIR(status.st_mode))
+	{
+		files.push_back(path);
+		return;
+	}
+	DIR *dir=opendir(path.c_str());
+	if (!dir)
+	{
+		fprintf(stderr, "ERROR: can not open the directory %s\n", path.c_str());
+		return;
+	}
+	std::vector<std::string> names;
+	while (struct dirent *entry=readdir(dir))
+	{
+		std::string name(entry->d_name);
+		if (name.empty() || name[0]=='.') continue;
+		names.push_back(name);
+	}
+	closedir(dir);
+	// sort the names to obtain the same order in each run
+	std::sort(names.begin(), names.end());
+	for (auto const &name : names)
+		addFiles(path+"/"+name, files);
+}
+
+//! returns a JSON string
+static std::string getJSONString(std::string const &str)
+{
+	std::string res("\"");
+	for (auto c : str)
+	{
+		if (c=='"' || c=='\\')
+			res+='\\';
+		else if (static_cast<unsigned char>(c)<0x20)
+		{
+			char buffer[10];
+			snprintf(buffer, sizeof(buffer), "\\u%04x", int(c));
+			res+=buffer;
+			continue;
+		}
+		res+=c;
+	}
+	return res+"\"";
+}
+
+//! prints a result in a table row
+static void printRow(Result const &res)
+{
+	if (res.m_numRuns<=0)
+	{
+		printf("%-40s %10ld  ERROR: %s\n", res.m_file.c_str(), res.m_size, res.m_error.c_str());
+		return;
+	}
+	double const wall=res.m_wallTime/res.m_numRuns, cpu=res.m_cpuTime/res.m_numRuns;
+	printf("%-40s %10ld %6d %10.3f %10.3f %10.2f %12lu %12lu %10ld\n", res.m_file.c_str(), res.m_size, res.m_numRuns,
+	       1000*wall, 1000*cpu, wall>0 ? double(res.m_size)/wall/(1024.*1024.) : 0,
+	       res.m_numAllocations/static_cast<unsigned long>(res.m_numRuns),
+	       res.m_allocatedSize/static_cast<unsigned long>(res.m_numRuns), res.m_peakRSS);
+}
+
+//! prints a result in JSON format
+static void printJSON(Result const &res, bool last)
+{
+	printf("\t\t{\"file\": %s, \"size\": %ld, \"runs\": %d", getJSONString(res.m_file).c_str(), res.m_size, res.m_numRuns);
+	if (res.m_numRuns>0)
+	{
+		double const wall=res.m_wallTime/res.m_numRuns;
+		printf(", \"wall\": %g, \"cpu\": %g, \"bytesPerSecond\": %g, \"allocations\": %lu, \"allocatedBytes\": %lu, \"peakRSS\": %ld",
+		       wall, res.m_cpuTime/res.m_numRuns, wall>0 ? double(res.m_size)/wall : 0,
+		       res.m_numAllocations/static_cast<unsigned long>(res.m_numRuns),
+		       res.m_allocatedSize/static_cast<unsigned long>(res.m_numRuns), res.m_peakRSS);
+	}
+	if (!res.m_error.empty())
+		printf(", \"error\": %s", getJSONString(res.m_error).c_str());
+	if (res.m_tracer)
+		printf(", \"io\": %s", res.m_tracer->getJSONSummary().c_str());
+	printf("}%s\n", last ? "" : ",");
+}
+}
+
+static int printUsage()
+{
+	printf("`wps-bench' measures the time and the memory needed to read some documents.\n");
+	printf("Each file is detected then parsed several times; for each file and for all the\n");
+	printf("files, it reports the wall time and the processor time per run, the number of bytes\n");
+	printf("read per second, the number of allocations and the allocated size per run and the\n");
+	printf("peak resident set size. If a directory is given, all its files are read.\n");
+	printf("\n");
+	printf("Usage: wps-bench [OPTION] FILE|DIRECTORY...\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("\t-e ENCODING        define the file encoding, see wps2text -h\n");
+	printf("\t-h                 show this help message\n");
+	printf("\t-j                 write the report in JSON format\n");
+	printf("\t-m MODE            the measured phases, where mode can be\n");
+	printf("\t\t detect: the format detection only,\n");
+	printf("\t\t parse: the detection and the parsing with a no-op interface,\n");
+	printf("\t\t emit: the detection and the parsing with a text interface (default).\n");
+	printf("\t-n NUM             run NUM times on each file (default 5)\n");
+	printf("\t-p PASSWORD        set password to open the files\n");
+	printf("\t-t                 do a last traced run and report how the file is read: the number\n");
+	printf("\t\t of bytes read, of reread bytes, of backward seeks and the read sizes\n");
+	printf("\t-v                 show version information\n");
+	printf("\n");
+	printf("Report bugs to <https://sourceforge.net/p/libwps/bugs/> or <https://bugs.documentfoundation.org/>.\n");
+	return -1;
+}
+
+static int printVersion()
+{
+	printf("wps-bench %s\n", VERSION);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	bool printHelp=false;
+	bool json=false;
+	bool trace=false;
+	int ch;
+	char const *encoding="";
+	char const *password=nullptr;
+	int numRuns=5;
+	wpsBench::Mode mode=wpsBench::M_Emit;
+
+	while ((ch = getopt(argc, argv, "e:hjm:n:p:tv")) != -1)
+	{
+		switch (ch)
+		{
+		case 'e':
+			encoding=optarg;
+			break;
+		case 'j':
+			json=true;
+			break;
+		case 'm':
+			if (strcmp(optarg, "detect")==0)
+				mode=wpsBench::M_Detect;
+			else if (strcmp(optarg, "parse")==0)
+				mode=wpsBench::M_Parse;
+			else if (strcmp(optarg, "emit")==0)
+				mode=wpsBench::M_Emit;
+			else
+				printHelp=true;
+			break;
+		case 'n':
+			numRuns=std::atoi(optarg);
+			break;
+		case 'p':
+			password=optarg;
+			break;
+		case 't':
+			trace=true;
+			break;
+		case 'v':
+			printVersion();
+			return 0;
+		default:
+		case 'h':
+			printHelp = true;
+			break;
+		}
+	}
+	if (argc < 1+optind || numRuns<=0 || printHelp)
+	{
+		printUsage();
+		return -1;
+	}
+
+	std::vector<std::string> files;
+	for (int f=optind; f<argc; ++f)
+		wpsBench::addFiles(argv[f], files);
+
+	std::vector<wpsBench::Result> results;
+	wpsBench::Result total("total");
+	total.m_numRuns=numRuns;
+	bool ok=true;
+	for (auto const &file : files)
+	{
+		results.push_back(wpsBench::benchFile(file, numRuns, mode, password, encoding, trace));
+		auto const &res=results.back();
+		if (res.m_numRuns!=numRuns)
+		{
+			ok=false;
+			continue;
+		}
+		total.m_size+=res.m_size;
+		total.m_wallTime+=res.m_wallTime;
+		total.m_cpuTime+=res.m_cpuTime;
+		total.m_numAllocations+=res.m_numAllocations;
+		total.m_allocatedSize+=res.m_allocatedSize;
+		total.m_peakRSS=res.m_peakRSS;
+	}
+
+	if (json)
+	{
+		printf("{\n\t\"files\": [\n");
+		for (size_t i=0; i<results.size(); ++i)
+			wpsBench::printJSON(results[i], i+1==results.size());
+		printf("\t],\n\t\"total\":\n");
+		wpsBench::printJSON(total, true);
+		printf("}\n");
+	}
+	else
+	{
+		printf("%-40s %10s %6s %10s %10s %10s %12s %12s %10s\n", "file", "size", "runs", "wall(ms)", "cpu(ms)", "MB/s",
+		       "allocs/run", "bytes/run", "RSS(kB)");
+		for (auto const &res : results)
+			wpsBench::printRow(res);
+		wpsBench::printRow(total);
+		for (auto const &res : results)
+		{
+			if (!res.m_tracer) continue;
+			printf("\n%s:\n", res.m_file.c_str());
+			res.m_tracer->printSummary(stdout);
+		}
+	}
+	return ok ? 0 : 1;
+}
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,694 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+
+#include "helper.h"
+
+#include "eventLog.h"
+
+namespace libwpsHelper
+{
+namespace EventLogInternal
+{
+//! the log signature
+static char const s_signature[]="WPSEVLOG";
+//! the log version
+static int const s_version=1;
+//! the kind of interface
+enum Kind { K_Text=0, K_Spreadsheet };
+//! defines the event of an interface method
+#define WPS_EVENT_ID(name) E_##name,
+//! the events: the text interface calls then the calls which only exist in the spreadsheet interface
+enum Event
+{
+	WPS_TEXT_INTERFACE_METHODS(WPS_EVENT_ID, WPS_EVENT_ID, WPS_EVENT_ID, WPS_EVENT_ID, WPS_EVENT_ID)
+	WPS_SPREADSHEET_INTERFACE_METHODS(WPS_EVENT_ID, WPS_EVENT_ID)
+	E_NumEvents
+};
+#undef WPS_EVENT_ID
+//! the argument of an event
+enum Payload { P_None, P_String, P_PropertyList };
+//! the property types
+enum PropertyType { T_String=0, T_Int, T_Bool, T_Double, T_Vector };
+
+//! defines the switch case of an event
+#define WPS_EVENT_CASE(name) case E_##name:
+//! returns the argument type of an event
+Payload getPayload(int event)
+{
+	switch (event)
+	{
+	WPS_TEXT_INTERFACE_METHODS(WPS_IGNORE_METHOD, WPS_EVENT_CASE, WPS_IGNORE_METHOD, WPS_IGNORE_METHOD, WPS_EVENT_CASE)
+	WPS_SPREADSHEET_INTERFACE_METHODS(WPS_IGNORE_METHOD, WPS_EVENT_CASE)
+		return P_None;
+	WPS_TEXT_INTERFACE_METHODS(WPS_IGNORE_METHOD, WPS_IGNORE_METHOD, WPS_EVENT_CASE, WPS_IGNORE_METHOD, WPS_IGNORE_METHOD)
+		return P_String;
+	default:
+		break;
+	}
+	return P_PropertyList;
+}
+#undef WPS_EVENT_CASE
+
+//! returns true if two properties give the same values
+static bool isSameProperty(librevenge::RVNGProperty const &prop1, librevenge::RVNGProperty const &prop2)
+{
+	return prop1.getUnit()==prop2.getUnit() && prop1.getInt()==prop2.getInt() &&
+	       prop1.getDouble()==prop2.getDouble() && prop1.getStr()==prop2.getStr();
+}
+
+//! the class used to write an event log
+class Writer
+{
+public:
+	//! constructor
+	explicit Writer(Kind kind)
+		: m_data()
+		, m_keyToIdMap()
+	{
+		m_data.assign(s_signature, s_signature+8);
+		m_data.push_back(static_cast<unsigned char>(s_version));
+		m_data.push_back(static_cast<unsigned char>(kind));
+	}
+	//! adds an event without argument
+	void add(Event event)
+	{
+		writeVarint(static_cast<unsigned long>(event));
+	}
+	//! adds an event with a string
+	void add(Event event, librevenge::RVNGString const &text)
+	{
+		add(event);
+		writeString(text.cstr(), size_t(text.size()));
+	}
+	//! adds an event with a property list
+	void add(Event event, librevenge::RVNGPropertyList const &propList)
+	{
+		add(event);
+		writePropertyList(propList);
+	}
+	//! the log
+	std::vector<unsigned char> m_data;
+protected:
+	//! writes an unsigned value, 7 bits by byte
+	void writeVarint(unsigned long long value)
+	{
+		while (value>=0x80)
+		{
+			m_data.push_back(static_cast<unsigned char>((value&0x7f)|0x80));
+			value>>=7;
+		}
+		m_data.push_back(static_cast<unsigned char>(value));
+	}
+	//! writes a string: its length then its characters
+	void writeString(char const *str, size_t len)
+	{
+		writeVarint(static_cast<unsigned long>(len));
+		m_data.insert(m_data.end(), str, str+len);
+	}
+	//! writes a key: its index and if this is a new key, its name
+	void writeKey(char const *key)
+	{
+		auto it=m_keyToIdMap.find(key);
+		if (it!=m_keyToIdMap.end())
+		{
+			writeVarint(it->second);
+			return;
+		}
+		auto id=static_cast<unsigned long>(m_keyToIdMap.size());
+		m_keyToIdMap[key]=id;
+		writeVarint(id);
+		writeString(key, strlen(key));
+	}
+	//! writes a property list
+	void writePropertyList(librevenge::RVNGPropertyList const &propList)
+	{
+		librevenge::RVNGPropertyList::Iter i(propList);
+		unsigned long numEntries=0;
+		for (i.rewind(); i.next();)
+		{
+			if (i.child() || i()) ++numEntries;
+		}
+		writeVarint(numEntries);
+		for (i.rewind(); i.next();)
+		{
+			auto const *child=i.child();
+			if (child)
+			{
+				writeKey(i.key());
+				m_data.push_back(T_Vector);
+				writeVarint(child->count());
+				for (unsigned long c=0; c<child->count(); ++c)
+					writePropertyList((*child)[c]);
+			}
+			else if (i())
+			{
+				writeKey(i.key());
+				writeProperty(*i());
+			}
+		}
+	}
+	/** writes a property.
+
+		The property classes are not public, so the type is found by
+		creating a property from the values and checking that it gives
+		the same results. If not, the property is stored as a string.
+	 */
+	void writeProperty(librevenge::RVNGProperty const &prop)
+	{
+		auto unit=prop.getUnit();
+		auto str=prop.getStr();
+		librevenge::RVNGPropertyList check;
+		if (unit==librevenge::RVNG_GENERIC)
+		{
+			int value=prop.getInt();
+			if (str=="true" || str=="false")
+			{
+				check.insert("v", value!=0);
+				if (isSameProperty(prop, *check["v"]))
+				{
+					m_data.push_back(T_Bool);
+					m_data.push_back(value ? 1 : 0);
+					return;
+				}
+			}
+			check.insert("v", value);
+			if (isSameProperty(prop, *check["v"]))
+			{
+				m_data.push_back(T_Int);
+				// zigzag encoding to store the small negative values in few bytes
+				writeVarint(value<0 ? (static_cast<unsigned long long>(-(static_cast<long long>(value)+1))<<1)|1 :
+				            static_cast<unsigned long long>(value)<<1);
+				return;
+			}
+		}
+		double value=prop.getDouble();
+		check.insert("v", value, unit);
+		if (isSameProperty(prop, *check["v"]))
+		{
+			m_data.push_back(T_Double);
+			unsigned long long bits;
+			static_assert(sizeof(bits)==sizeof(value), "unexpected double size");
+			memcpy(&bits, &value, sizeof(value));
+			for (int b=0; b<8; ++b, bits>>=8)
+				m_data.push_back(static_cast<unsigned char>(bits&0xff));
+			m_data.push_back(static_cast<unsigned char>(unit));
+			return;
+		}
+		m_data.push_back(T_String);
+		writeString(str.cstr(), size_t(str.size()));
+	}
+	//! a map key to index
+	std::map<std::string, unsigned long> m_keyToIdMap;
+private:
+	Writer(Writer const &) = delete;
+	Writer &operator=(Writer const &) = delete;
+};
+
+//! the class used to read an event log
+class Reader
+{
+public:
+	//! constructor
+	explicit Reader(std::vector<unsigned char> const &data)
+		: m_data(data.empty() ? nullptr : &data[0])
+		, m_pos(0)
+		, m_size(data.size())
+		, m_keys()
+	{
+	}
+	//! reads the log header, returns false if the log is not valid
+	bool readHeader(Kind &kind)
+	{
+		if (m_size<10 || memcmp(m_data, s_signature, 8)!=0 || m_data[8]!=s_version || m_data[9]>K_Spreadsheet)
+		{
+			WPS_DEBUG_MSG(("EventLogInternal::Reader::readHeader: the header is not valid\n"));
+			return false;
+		}
+		kind=Kind(m_data[9]);
+		m_pos=10;
+		return true;
+	}
+	//! returns true if all the events are read
+	bool atEnd() const
+	{
+		return m_pos>=m_size;
+	}
+	//! reads an event and its argument
+	bool readEvent(int &event, librevenge::RVNGString &text, librevenge::RVNGPropertyList &propList)
+	{
+		unsigned long long value;
+		if (!readVarint(value) || value>=E_NumEvents)
+		{
+			WPS_DEBUG_MSG(("EventLogInternal::Reader::readEvent: can not read an event at position %ld\n", long(m_pos)));
+			return false;
+		}
+		event=int(value);
+		switch (getPayload(event))
+		{
+		case P_String:
+			return readString(text);
+		case P_PropertyList:
+			propList.clear();
+			return readPropertyList(propList, 0);
+		case P_None:
+		default:
+			break;
+		}
+		return true;
+	}
+protected:
+	//! reads an unsigned value
+	bool readVarint(unsigned long long &value)
+	{
+		value=0;
+		for (int shift=0; shift<64 && m_pos<m_size; shift+=7)
+		{
+			unsigned char c=m_data[m_pos++];
+			value|=static_cast<unsigned long long>(c&0x7f)<<shift;
+			if ((c&0x80)==0) return true;
+		}
+		return false;
+	}
+	//! reads a string
+	bool readString(std::string &str)
+	{
+		unsigned long long len;
+		if (!readVarint(len) || len>m_size-m_pos) return false;
+		str.assign(reinterpret_cast<char const *>(m_data+m_pos), size_t(len));
+		m_pos+=size_t(len);
+		return true;
+	}
+	//! reads a string
+	bool readString(librevenge::RVNGString &text)
+	{
+		std::string str;
+		if (!readString(str)) return false;
+		text=str.c_str();
+		return true;
+	}
+	//! reads a key
+	bool readKey(std::string &key)
+	{
+		unsigned long long id;
+		if (!readVarint(id) || id>m_keys.size()) return false;
+		if (id==m_keys.size())
+		{
+			if (!readString(key)) return false;
+			m_keys.push_back(key);
+			return true;
+		}
+		key=m_keys[size_t(id)];
+		return true;
+	}
+	//! reads a property list
+	bool readPropertyList(librevenge::RVNGPropertyList &propList, int depth)
+	{
+		unsigned long long numEntries;
+		if (depth>50 || !readVarint(numEntries) || numEntries>m_size-m_pos)
+			return false;
+		std::string key;
+		for (unsigned long long e=0; e<numEntries; ++e)
+		{
+			if (!readKey(key) || m_pos>=m_size) return false;
+			switch (m_data[m_pos++])
+			{
+			case T_String:
+			{
+				librevenge::RVNGString text;
+				if (!readString(text)) return false;
+				propList.insert(key.c_str(), text);
+				break;
+			}
+			case T_Int:
+			{
+				unsigned long long value;
+				if (!readVarint(value)) return false;
+				propList.insert(key.c_str(), (value&1) ? int(-static_cast<long long>(value>>1)-1) : int(value>>1));
+				break;
+			}
+			case T_Bool:
+				if (m_pos>=m_size) return false;
+				propList.insert(key.c_str(), m_data[m_pos++]!=0);
+				break;
+			case T_Double:
+			{
+				if (m_size-m_pos<9) return false;
+				unsigned long long bits=0;
+				for (int b=7; b>=0; --b)
+					bits=(bits<<8)|m_data[m_pos+size_t(b)];
+				double value;
+				memcpy(&value, &bits, sizeof(value));
+				int unit=m_data[m_pos+8];
+				m_pos+=9;
+				if (unit>librevenge::RVNG_UNIT_ERROR) return false;
+				propList.insert(key.c_str(), value, librevenge::RVNGUnit(unit));
+				break;
+			}
+			case T_Vector:
+			{
+				unsigned long long num;
+				if (!readVarint(num) || num>m_size-m_pos) return false;
+				librevenge::RVNGPropertyListVector vect;
+				for (unsigned long long c=0; c<num; ++c)
+				{
+					librevenge::RVNGPropertyList child;
+					if (!readPropertyList(child, depth+1)) return false;
+					vect.append(child);
+				}
+				propList.insert(key.c_str(), vect);
+				break;
+			}
+			default:
+				WPS_DEBUG_MSG(("EventLogInternal::Reader::readPropertyList: unknown property type\n"));
+				return false;
+			}
+		}
+		return true;
+	}
+	//! the data
+	unsigned char const *m_data;
+	//! the current position
+	size_t m_pos;
+	//! the data size
+	size_t m_size;
+	//! the keys already read
+	std::vector<std::string> m_keys;
+private:
+	Reader(Reader const &) = delete;
+	Reader &operator=(Reader const &) = delete;
+};
+}
+
+////////////////////////////////////////////////////////////
+// TextEventRecorder
+////////////////////////////////////////////////////////////
+TextEventRecorder::TextEventRecorder()
+	: librevenge::RVNGTextInterface()
+	, m_writer(new EventLogInternal::Writer(EventLogInternal::K_Text))
+{
+}
+
+TextEventRecorder::~TextEventRecorder()
+{
+}
+
+std::vector<unsigned char> const &TextEventRecorder::getData() const
+{
+	return m_writer->m_data;
+}
+
+//! defines the recorder methods: add the event in the log
+#define WPS_LOG_PROPLIST_METHOD(Recorder, name) \
+void Recorder::name(const librevenge::RVNGPropertyList &propList) \
+{ \
+	m_writer->add(EventLogInternal::E_##name, propList); \
+}
+#define WPS_LOG_NOARG_METHOD(Recorder, name) \
+void Recorder::name() \
+{ \
+	m_writer->add(EventLogInternal::E_##name); \
+}
+#define WPS_LOG_STRING_METHOD(Recorder, name) \
+void Recorder::name(const librevenge::RVNGString &text) \
+{ \
+	m_writer->add(EventLogInternal::E_##name, text); \
+}
+
+#define WPS_TEXT_LOG_PROPLIST_METHOD(name) WPS_LOG_PROPLIST_METHOD(TextEventRecorder, name)
+#define WPS_TEXT_LOG_NOARG_METHOD(name) WPS_LOG_NOARG_METHOD(TextEventRecorder, name)
+#define WPS_TEXT_LOG_STRING_METHOD(name) WPS_LOG_STRING_METHOD(TextEventRecorder, name)
+WPS_TEXT_INTERFACE_METHODS(WPS_TEXT_LOG_PROPLIST_METHOD, WPS_TEXT_LOG_NOARG_METHOD, WPS_TEXT_LOG_STRING_METHOD,
+                           WPS_TEXT_LOG_PROPLIST_METHOD, WPS_TEXT_LOG_NOARG_METHOD)
+
+////////////////////////////////////////////////////////////
+// SpreadsheetEventRecorder
+////////////////////////////////////////////////////////////
+SpreadsheetEventRecorder::SpreadsheetEventRecorder()
+	: librevenge::RVNGSpreadsheetInterface()
+	, m_writer(new EventLogInternal::Writer(EventLogInternal::K_Spreadsheet))
+{
+}
+
+SpreadsheetEventRecorder::~SpreadsheetEventRecorder()
+{
+}
+
+std::vector<unsigned char> const &SpreadsheetEventRecorder::getData() const
+{
+	return m_writer->m_data;
+}
+
+#define WPS_SPREADSHEET_LOG_PROPLIST_METHOD(name) WPS_LOG_PROPLIST_METHOD(SpreadsheetEventRecorder, name)
+#define WPS_SPREADSHEET_LOG_NOARG_METHOD(name) WPS_LOG_NOARG_METHOD(SpreadsheetEventRecorder, name)
+#define WPS_SPREADSHEET_LOG_STRING_METHOD(name) WPS_LOG_STRING_METHOD(SpreadsheetEventRecorder, name)
+WPS_TEXT_INTERFACE_METHODS(WPS_SPREADSHEET_LOG_PROPLIST_METHOD, WPS_SPREADSHEET_LOG_NOARG_METHOD, WPS_SPREADSHEET_LOG_STRING_METHOD,
+                           WPS_IGNORE_METHOD, WPS_IGNORE_METHOD)
+WPS_SPREADSHEET_INTERFACE_METHODS(WPS_SPREADSHEET_LOG_PROPLIST_METHOD, WPS_SPREADSHEET_LOG_NOARG_METHOD)
+
+////////////////////////////////////////////////////////////
+// replay
+////////////////////////////////////////////////////////////
+//! the replay switch cases: call the listener method of an event
+#define WPS_REPLAY_PROPLIST_CASE(name) \
+case EventLogInternal::E_##name: \
+	listener.name(propList); \
+	break;
+#define WPS_REPLAY_NOARG_CASE(name) \
+case EventLogInternal::E_##name: \
+	listener.name(); \
+	break;
+#define WPS_REPLAY_STRING_CASE(name) \
+case EventLogInternal::E_##name: \
+	listener.name(text); \
+	break;
+
+bool isTextEventLog(std::vector<unsigned char> const &data)
+{
+	EventLogInternal::Reader reader(data);
+	EventLogInternal::Kind kind=EventLogInternal::K_Spreadsheet;
+	return reader.readHeader(kind) && kind==EventLogInternal::K_Text;
+}
+
+bool replayEventLog(std::vector<unsigned char> const &data, librevenge::RVNGTextInterface &listener)
+{
+	EventLogInternal::Reader reader(data);
+	EventLogInternal::Kind kind;
+	if (!reader.readHeader(kind) || kind!=EventLogInternal::K_Text)
+		return false;
+	int event;
+	librevenge::RVNGString text;
+	librevenge::RVNGPropertyList propList;
+	while (!reader.atEnd())
+	{
+		if (!reader.readEvent(event, text, propList))
+			return false;
+		switch (event)
+		{
+		WPS_TEXT_INTERFACE_METHODS(WPS_REPLAY_PROPLIST_CASE, WPS_REPLAY_NOARG_CASE, WPS_REPLAY_STRING_CASE,
+		                           WPS_REPLAY_PROPLIST_CASE, WPS_REPLAY_NOARG_CASE)
+		default:
+			WPS_DEBUG_MSG(("replayEventLog: find unexpected text event %d\n", event));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool replayEventLog(std::vector<unsigned char> const &data, librevenge::RVNGSpreadsheetInterface &listener)
+{
+	EventLogInternal::Reader reader(data);
+	EventLogInternal::Kind kind;
+	if (!reader.readHeader(kind) || kind!=EventLogInternal::K_Spreadsheet)
+		return false;
+	int event;
+	librevenge::RVNGString text;
+	librevenge::RVNGPropertyList propList;
+	while (!reader.atEnd())
+	{
+		if (!reader.readEvent(event, text, propList))
+			return false;
+		switch (event)
+		{
+		WPS_TEXT_INTERFACE_METHODS(WPS_REPLAY_PROPLIST_CASE, WPS_REPLAY_NOARG_CASE, WPS_REPLAY_STRING_CASE,
+		                           WPS_IGNORE_METHOD, WPS_IGNORE_METHOD)
+		WPS_SPREADSHEET_INTERFACE_METHODS(WPS_REPLAY_PROPLIST_CASE, WPS_REPLAY_NOARG_CASE)
+		default:
+			WPS_DEBUG_MSG(("replayEventLog: find unexpected spreadsheet event %d\n", event));
+			return false;
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+// file
+////////////////////////////////////////////////////////////
+bool readEventLog(char const *file, std::vector<unsigned char> &data)
+{
+	data.clear();
+	FILE *f=file ? fopen(file, "rb") : nullptr;
+	if (!f)
+	{
+		fprintf(stderr, "ERROR: can not open the file \"%s\"\n", file ? file : "");
+		return false;
+	}
+	bool ok=fseek(f, 0, SEEK_END)==0;
+	long size=ok ? ftell(f) : -1;
+	if (size<0 || fseek(f, 0, SEEK_SET)!=0)
+		ok=false;
+	else
+	{
+		data.resize(size_t(size));
+		ok=size==0 || fread(&data[0], 1, size_t(size), f)==size_t(size);
+	}
+	fclose(f);
+	if (!ok)
+		fprintf(stderr, "ERROR: can not read the file \"%s\"\n", file);
+	return ok;
+}
+
+bool writeEventLog(char const *file, std::vector<unsigned char> const &data)
+{
+	FILE *f=file ? fopen(file, "wb") : nullptr;
+	if (!f)
+	{
+		fprintf(stderr, "ERROR: can not create the file \"%s\"\n", file ? file : "");
+		return false;
+	}
+	bool ok=data.empty() || fwrite(&data[0], 1, data.size(), f)==data.size();
+	if (fclose(f)!=0) ok=false;
+	if (!ok)
+		fprintf(stderr, "ERROR: can not write the file \"%s\"\n", file);
+	return ok;
+}
+
+////////////////////////////////////////////////////////////
+// cache
+////////////////////////////////////////////////////////////
+namespace EventLogInternal
+{
+//! the FNV-1a hash of a content
+struct Hash
+{
+	//! constructor
+	Hash()
+		: m_value(0xcbf29ce484222325ULL)
+		, m_size(0)
+	{
+	}
+	//! adds some data to the hash
+	void add(unsigned char const *data, unsigned long size)
+	{
+		for (unsigned long i=0; i<size; ++i)
+		{
+			m_value^=data[i];
+			m_value*=0x100000001b3ULL;
+		}
+		m_size+=size;
+	}
+	//! adds a string and its final 0 to the hash
+	void add(char const *str)
+	{
+		if (!str) str="";
+		add(reinterpret_cast<unsigned char const *>(str), static_cast<unsigned long>(strlen(str)+1));
+	}
+	/** adds the content of a stream to the hash: its data or, if it
+		has no data (a folder), the name and the content of its sub streams */
+	bool add(librevenge::RVNGInputStream &input)
+	{
+		if (input.seek(0, librevenge::RVNG_SEEK_SET)!=0)
+			return false;
+		unsigned long const oldSize=m_size;
+		while (!input.isEnd())
+		{
+			unsigned long numRead;
+			unsigned char const *data=input.read(65536, numRead);
+			if (!data || !numRead) break;
+			add(data, numRead);
+		}
+		input.seek(0, librevenge::RVNG_SEEK_SET);
+		if (m_size!=oldSize || !input.isStructured())
+			return true;
+		for (unsigned id=0; id<input.subStreamCount(); ++id)
+		{
+			add(input.subStreamName(id));
+			std::unique_ptr<librevenge::RVNGInputStream> subStream(input.getSubStreamById(id));
+			if (!subStream || !add(*subStream))
+				return false;
+		}
+		return true;
+	}
+	//! the hash value
+	unsigned long long m_value;
+	//! the number of hashed bytes
+	unsigned long m_size;
+};
+}
+
+std::string getEventLogCacheFile(char const *cacheDir, librevenge::RVNGInputStream &input, std::string const &key)
+{
+	EventLogInternal::Hash hash;
+	if (!cacheDir || !hash.add(input))
+	{
+		fprintf(stderr, "ERROR: can not compute the hash of the input\n");
+		return "";
+	}
+	unsigned long const size=hash.m_size;
+	hash.add(key.c_str());
+	char name[64];
+	snprintf(name, sizeof(name), "%016llx-%lx.wpslog", hash.m_value, size);
+	std::string res(cacheDir);
+	if (!res.empty() && res[res.size()-1]!='/')
+		res+='/';
+	return res+name;
+}
+
+bool readCachedEventLog(std::string const &cacheFile, std::vector<unsigned char> &data)
+{
+	data.clear();
+	FILE *f=fopen(cacheFile.c_str(), "rb");
+	if (!f)
+		return false;
+	fclose(f);
+	return readEventLog(cacheFile.c_str(), data);
+}
+
+bool writeCachedEventLog(std::string const &cacheFile, std::vector<unsigned char> const &data)
+{
+	// the log is written in a temporary file first, so that another
+	// process never reads a partial log
+	std::string const tmpFile=cacheFile+".tmp";
+	if (!writeEventLog(tmpFile.c_str(), data))
+	{
+		remove(tmpFile.c_str());
+		return false;
+	}
+	if (rename(tmpFile.c_str(), cacheFile.c_str())!=0)
+	{
+		fprintf(stderr, "ERROR: can not create the file \"%s\"\n", cacheFile.c_str());
+		remove(tmpFile.c_str());
+		return false;
+	}
+	return true;
+}
+}
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,118 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef EVENT_LOG_H
+#  define EVENT_LOG_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+#include "WPSInterfaceMethods.h"
+
+/* an event log stores in a compact binary form the sequence of calls
+   which a parser sends to a librevenge interface, so that they can be
+   replayed later to any generator without parsing the file again.
+
+   The log begins with an 8 bytes signature, a version and the kind of
+   interface, then each call is stored as its event number followed by
+   its argument. The property list keys are stored once, the next uses
+   refer to them by their index.
+ */
+namespace libwpsHelper
+{
+namespace EventLogInternal
+{
+class Writer;
+}
+
+/** a text interface which records the calls it receives in an event log */
+class TextEventRecorder final : public librevenge::RVNGTextInterface
+{
+public:
+	//! constructor
+	TextEventRecorder();
+	//! destructor
+	~TextEventRecorder() final;
+	//! returns the event log
+	std::vector<unsigned char> const &getData() const;
+
+	WPS_DECLARE_TEXT_INTERFACE_METHODS
+
+private:
+	TextEventRecorder(TextEventRecorder const &) = delete;
+	TextEventRecorder &operator=(TextEventRecorder const &) = delete;
+	//! the log writer
+	std::unique_ptr<EventLogInternal::Writer> m_writer;
+};
+
+/** a spreadsheet interface which records the calls it receives in an event log */
+class SpreadsheetEventRecorder final : public librevenge::RVNGSpreadsheetInterface
+{
+public:
+	//! constructor
+	SpreadsheetEventRecorder();
+	//! destructor
+	~SpreadsheetEventRecorder() final;
+	//! returns the event log
+	std::vector<unsigned char> const &getData() const;
+
+	WPS_DECLARE_SPREADSHEET_INTERFACE_METHODS
+
+private:
+	SpreadsheetEventRecorder(SpreadsheetEventRecorder const &) = delete;
+	SpreadsheetEventRecorder &operator=(SpreadsheetEventRecorder const &) = delete;
+	//! the log writer
+	std::unique_ptr<EventLogInternal::Writer> m_writer;
+};
+
+/** replays a text event log in listener, returns false if the log is
+	not a valid text event log.
+
+	\note if the log is truncated, the events before the problem are
+	sent to the listener */
+bool replayEventLog(std::vector<unsigned char> const &data, librevenge::RVNGTextInterface &listener);
+/** replays a spreadsheet event log in listener, returns false if the
+	log is not a valid spreadsheet event log */
+bool replayEventLog(std::vector<unsigned char> const &data, librevenge::RVNGSpreadsheetInterface &listener);
+//! returns true if data is a text event log, false if it is a spreadsheet event log or if it is not valid
+bool isTextEventLog(std::vector<unsigned char> const &data);
+
+//! reads an event log from a file
+bool readEventLog(char const *file, std::vector<unsigned char> &data);
+//! writes an event log in a file
+bool writeEventLog(char const *file, std::vector<unsigned char> const &data);
+
+/** returns the name of the file which stores the event log of input in
+	the cache directory cacheDir, or an empty string if input can not be
+	read.
+
+	The name is built from a hash of the input's content and of key (the
+	password, the library version, ...), so a modified file or a new
+	version of the library gives another name.
+
+	\note the hash is not a cryptographic hash, so the cache must only
+	be used for trusted files */
+std::string getEventLogCacheFile(char const *cacheDir, librevenge::RVNGInputStream &input, std::string const &key);
+//! reads the event log stored in the cache file, returns false without printing an error if it does not exist
+bool readCachedEventLog(std::string const &cacheFile, std::vector<unsigned char> &data);
+//! stores an event log in the cache file: writes it in a temporary file and renames it
+bool writeCachedEventLog(std::string const &cacheFile, std::vector<unsigned char> const &data);
+}
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
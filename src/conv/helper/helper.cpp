@@ -280,6 +280,10 @@ bool checkErrorAndPrintMessage(libwps::WPSResult result)
 		fprintf(stderr, "ERROR: Parse Exception!\n");
 	else if (result == libwps::WPS_OLE_ERROR)
 		fprintf(stderr, "ERROR: File is an OLE document, but does not contain a Microsoft Works stream!\n");
+	else if (result == libwps::WPS_LIMIT_EXCEEDED_ERROR)
+		fprintf(stderr, "ERROR: The parsing exceeds a resource limit!\n");
+	else if (result == libwps::WPS_CANCELLED_ERROR)
+		fprintf(stderr, "ERROR: The parsing was cancelled!\n");
 	else if (result != libwps::WPS_OK)
 		fprintf(stderr, "ERROR: Unknown Error!\n");
 	else
@@ -0,0 +1,153 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+#include "memoryCounter.h"
+
+namespace libwpsHelper
+{
+namespace MemoryCounterInternal
+{
+//! the number of allocations
+static std::atomic<unsigned long> s_numAllocations(0);
+//! the allocated size
+static std::atomic<unsigned long> s_allocatedSize(0);
+//! the function called after each allocation
+static std::atomic<AllocationHook> s_allocationHook(nullptr);
+//! the function called when a block with a token is freed
+static std::atomic<FreeHook> s_freeHook(nullptr);
+//! the size of the header stored before each block: the block's size and the hook's token
+static std::size_t const s_headerSize=alignof(std::max_align_t)>2*sizeof(unsigned long) ? alignof(std::max_align_t) : 2*sizeof(unsigned long);
+
+//! allocates a block, updates the counters and calls the allocation hook if it is set
+static void *allocate(std::size_t size)
+{
+	s_numAllocations.fetch_add(1, std::memory_order_relaxed);
+	s_allocatedSize.fetch_add(static_cast<unsigned long>(size), std::memory_order_relaxed);
+	auto *block=static_cast<unsigned char *>(std::malloc(size+s_headerSize));
+	if (!block) throw std::bad_alloc();
+	auto *header=reinterpret_cast<unsigned long *>(block);
+	header[0]=static_cast<unsigned long>(size);
+	auto hook=s_allocationHook.load(std::memory_order_relaxed);
+	header[1]=hook ? hook(header[0]) : 0;
+	return block+s_headerSize;
+}
+
+//! frees a block allocated by allocate
+static void deallocate(void *ptr)
+{
+	if (!ptr) return;
+	auto *block=static_cast<unsigned char *>(ptr)-s_headerSize;
+	auto const *header=reinterpret_cast<unsigned long const *>(block);
+	if (header[1])
+	{
+		auto hook=s_freeHook.load(std::memory_order_relaxed);
+		if (hook) hook(header[1], header[0]);
+	}
+	std::free(block);
+}
+}
+
+unsigned long getTotalNumAllocations()
+{
+	return MemoryCounterInternal::s_numAllocations.load(std::memory_order_relaxed);
+}
+
+unsigned long getTotalAllocatedSize()
+{
+	return MemoryCounterInternal::s_allocatedSize.load(std::memory_order_relaxed);
+}
+
+void setAllocationHooks(AllocationHook allocationHook, FreeHook freeHook)
+{
+	MemoryCounterInternal::s_freeHook=freeHook;
+	MemoryCounterInternal::s_allocationHook=allocationHook;
+}
+
+long getPeakRSS()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage)!=0)
+		return -1;
+#  if defined(__APPLE__)
+	return long(usage.ru_maxrss/1024); // ru_maxrss is in bytes
+#  else
+	return long(usage.ru_maxrss); // ru_maxrss is in kilobytes
+#  endif
+#else
+	return -1;
+#endif
+}
+}
+
+void *operator new(std::size_t size)
+{
+	return libwpsHelper::MemoryCounterInternal::allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+	return libwpsHelper::MemoryCounterInternal::allocate(size);
+}
+
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept
+{
+	try
+	{
+		return libwpsHelper::MemoryCounterInternal::allocate(size);
+	}
+	catch (...)
+	{
+	}
+	return nullptr;
+}
+
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	libwpsHelper::MemoryCounterInternal::deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	libwpsHelper::MemoryCounterInternal::deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::nothrow_t const &) noexcept
+{
+	libwpsHelper::MemoryCounterInternal::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept
+{
+	libwpsHelper::MemoryCounterInternal::deallocate(ptr);
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
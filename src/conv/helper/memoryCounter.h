@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+
+#ifndef MEMORY_COUNTER_H
+#  define MEMORY_COUNTER_H
+
+/* the memory counters of the benchmark and profiling tools.
+
+   Linking memoryCounter.cpp replaces the global operators new and
+   delete, so all the allocations done by the program, including the
+   library's allocations, are counted. So it is built in its own
+   library, libconvMemory, which is only linked in the benchmark and
+   profiling tools; the converters keep the default operators.
+
+   \note a header is stored before each block, so a block allocated by
+   an operator new which is not replaced (for instance in a Windows DLL)
+   must not be freed by these operators: on Windows, the tools which use
+   this file must be linked statically.
+ */
+namespace libwpsHelper
+{
+//! a function called after each allocation, which returns a token or 0
+typedef unsigned long (*AllocationHook)(unsigned long size);
+//! a function called when a block whose allocation returns a non null token is freed
+typedef void (*FreeHook)(unsigned long token, unsigned long size);
+
+//! returns the total number of allocations since the program starts
+unsigned long getTotalNumAllocations();
+//! returns the total allocated size in bytes since the program starts
+unsigned long getTotalAllocatedSize();
+/** sets the functions called by the operators new and delete, for
+	instance libwps::WPSParseProfile::memoryAllocated and
+	libwps::WPSParseProfile::memoryFreed */
+void setAllocationHooks(AllocationHook allocationHook, FreeHook freeHook);
+//! returns the peak resident set size in kilobytes or -1 if it is unknown
+long getPeakRSS();
+}
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,152 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <librevenge-generators/librevenge-generators.h>
+
+#include "helper.h"
+
+#include "teeGenerator.h"
+
+namespace libwpsHelper
+{
+////////////////////////////////////////////////////////////
+// TextTee
+////////////////////////////////////////////////////////////
+TextTee::TextTee()
+	: librevenge::RVNGTextInterface()
+	, m_interfaces()
+{
+}
+
+TextTee::~TextTee()
+{
+}
+
+void TextTee::addInterface(librevenge::RVNGTextInterface *listener)
+{
+	if (!listener || listener==this)
+	{
+		WPS_DEBUG_MSG(("TextTee::addInterface: called with an invalid interface\n"));
+		return;
+	}
+	m_interfaces.push_back(listener);
+}
+
+//! defines the tee methods: send the call to each interface
+#define WPS_TEE_PROPLIST_METHOD(Tee, name) \
+void Tee::name(const librevenge::RVNGPropertyList &propList) \
+{ \
+	for (auto *listener : m_interfaces) listener->name(propList); \
+}
+#define WPS_TEE_NOARG_METHOD(Tee, name) \
+void Tee::name() \
+{ \
+	for (auto *listener : m_interfaces) listener->name(); \
+}
+#define WPS_TEE_STRING_METHOD(Tee, name) \
+void Tee::name(const librevenge::RVNGString &text) \
+{ \
+	for (auto *listener : m_interfaces) listener->name(text); \
+}
+
+#define WPS_TEXT_TEE_PROPLIST_METHOD(name) WPS_TEE_PROPLIST_METHOD(TextTee, name)
+#define WPS_TEXT_TEE_NOARG_METHOD(name) WPS_TEE_NOARG_METHOD(TextTee, name)
+#define WPS_TEXT_TEE_STRING_METHOD(name) WPS_TEE_STRING_METHOD(TextTee, name)
+WPS_TEXT_INTERFACE_METHODS(WPS_TEXT_TEE_PROPLIST_METHOD, WPS_TEXT_TEE_NOARG_METHOD, WPS_TEXT_TEE_STRING_METHOD,
+                           WPS_TEXT_TEE_PROPLIST_METHOD, WPS_TEXT_TEE_NOARG_METHOD)
+
+////////////////////////////////////////////////////////////
+// SpreadsheetTee
+////////////////////////////////////////////////////////////
+SpreadsheetTee::SpreadsheetTee()
+	: librevenge::RVNGSpreadsheetInterface()
+	, m_interfaces()
+{
+}
+
+SpreadsheetTee::~SpreadsheetTee()
+{
+}
+
+void SpreadsheetTee::addInterface(librevenge::RVNGSpreadsheetInterface *listener)
+{
+	if (!listener || listener==this)
+	{
+		WPS_DEBUG_MSG(("SpreadsheetTee::addInterface: called with an invalid interface\n"));
+		return;
+	}
+	m_interfaces.push_back(listener);
+}
+
+#define WPS_SPREADSHEET_TEE_PROPLIST_METHOD(name) WPS_TEE_PROPLIST_METHOD(SpreadsheetTee, name)
+#define WPS_SPREADSHEET_TEE_NOARG_METHOD(name) WPS_TEE_NOARG_METHOD(SpreadsheetTee, name)
+#define WPS_SPREADSHEET_TEE_STRING_METHOD(name) WPS_TEE_STRING_METHOD(SpreadsheetTee, name)
+WPS_TEXT_INTERFACE_METHODS(WPS_SPREADSHEET_TEE_PROPLIST_METHOD, WPS_SPREADSHEET_TEE_NOARG_METHOD, WPS_SPREADSHEET_TEE_STRING_METHOD,
+                           WPS_IGNORE_METHOD, WPS_IGNORE_METHOD)
+WPS_SPREADSHEET_INTERFACE_METHODS(WPS_SPREADSHEET_TEE_PROPLIST_METHOD, WPS_SPREADSHEET_TEE_NOARG_METHOD)
+
+////////////////////////////////////////////////////////////
+// output
+////////////////////////////////////////////////////////////
+bool parseOutputRequest(char const *arg, char const *const *validFormats, OutputRequest &request)
+{
+	char const *sep=arg ? strchr(arg, ':') : nullptr;
+	if (!sep || sep==arg || !sep[1])
+	{
+		fprintf(stderr, "ERROR: bad output \"%s\", expected FORMAT:FILE\n", arg ? arg : "");
+		return false;
+	}
+	request.m_format=std::string(arg, size_t(sep-arg));
+	request.m_file=sep+1;
+	for (char const *const *format=validFormats; format && *format; ++format)
+	{
+		if (request.m_format==*format)
+			return true;
+	}
+	fprintf(stderr, "ERROR: unknown output format \"%s\"\n", request.m_format.c_str());
+	return false;
+}
+
+std::unique_ptr<librevenge::RVNGTextInterface> createTextGenerator(std::string const &format, librevenge::RVNGString &document)
+{
+	if (format=="html")
+		return std::unique_ptr<librevenge::RVNGTextInterface>(new librevenge::RVNGHTMLTextGenerator(document));
+	if (format=="text")
+		return std::unique_ptr<librevenge::RVNGTextInterface>(new librevenge::RVNGTextTextGenerator(document));
+	WPS_DEBUG_MSG(("createTextGenerator: unknown format %s\n", format.c_str()));
+	return std::unique_ptr<librevenge::RVNGTextInterface>();
+}
+
+bool writeOutput(std::string const &file, librevenge::RVNGString const &data)
+{
+	FILE *f=fopen(file.c_str(), "wb");
+	if (!f)
+	{
+		fprintf(stderr, "ERROR: can not create the file \"%s\"\n", file.c_str());
+		return false;
+	}
+	auto len=size_t(data.size());
+	bool ok=fwrite(data.cstr(), 1, len, f)==len;
+	if (fclose(f)!=0) ok=false;
+	if (!ok)
+		fprintf(stderr, "ERROR: can not write the file \"%s\"\n", file.c_str());
+	return ok;
+}
+}
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
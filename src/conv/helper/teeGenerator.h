@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef TEE_GENERATOR_H
+#  define TEE_GENERATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+#include "WPSInterfaceMethods.h"
+
+namespace libwpsHelper
+{
+/** a text interface which sends each call it receives to several
+	interfaces, in the order where they were added.
+
+	This allows to create several outputs from only one parsing.
+ */
+class TextTee final : public librevenge::RVNGTextInterface
+{
+public:
+	//! constructor
+	TextTee();
+	//! destructor
+	~TextTee() final;
+	//! adds an interface, which is not owned by the tee
+	void addInterface(librevenge::RVNGTextInterface *listener);
+	//! returns the number of interfaces
+	size_t size() const
+	{
+		return m_interfaces.size();
+	}
+
+	WPS_DECLARE_TEXT_INTERFACE_METHODS
+
+private:
+	TextTee(TextTee const &) = delete;
+	TextTee &operator=(TextTee const &) = delete;
+	//! the interfaces
+	std::vector<librevenge::RVNGTextInterface *> m_interfaces;
+};
+
+/** a spreadsheet interface which sends each call it receives to
+	several interfaces, in the order where they were added.
+ */
+class SpreadsheetTee final : public librevenge::RVNGSpreadsheetInterface
+{
+public:
+	//! constructor
+	SpreadsheetTee();
+	//! destructor
+	~SpreadsheetTee() final;
+	//! adds an interface, which is not owned by the tee
+	void addInterface(librevenge::RVNGSpreadsheetInterface *listener);
+	//! returns the number of interfaces
+	size_t size() const
+	{
+		return m_interfaces.size();
+	}
+
+	WPS_DECLARE_SPREADSHEET_INTERFACE_METHODS
+
+private:
+	SpreadsheetTee(SpreadsheetTee const &) = delete;
+	SpreadsheetTee &operator=(SpreadsheetTee const &) = delete;
+	//! the interfaces
+	std::vector<librevenge::RVNGSpreadsheetInterface *> m_interfaces;
+};
+
+/** an output requested on the command line with -O FORMAT:FILE */
+struct OutputRequest
+{
+	//! constructor
+	OutputRequest()
+		: m_format()
+		, m_file()
+	{
+	}
+	//! the output format
+	std::string m_format;
+	//! the output file
+	std::string m_file;
+};
+
+/** parses a FORMAT:FILE output request, checking that FORMAT is one
+	of the formats in the null terminated list validFormats */
+bool parseOutputRequest(char const *arg, char const *const *validFormats, OutputRequest &request);
+/** creates a text generator for the format "html" or "text" which
+	stores its result in document */
+std::unique_ptr<librevenge::RVNGTextInterface> createTextGenerator(std::string const &format, librevenge::RVNGString &document);
+/** writes a converted document in a file, returns false if the file
+	can not be written */
+bool writeOutput(std::string const &file, librevenge::RVNGString const &data);
+}
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
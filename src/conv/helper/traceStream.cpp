@@ -0,0 +1,295 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "traceStream.h"
+
+namespace libwpsHelper
+{
+////////////////////////////////////////////////////////////
+// TraceData
+////////////////////////////////////////////////////////////
+TraceData::TraceData(std::string const &name, long size)
+	: m_name(name)
+	, m_size(size)
+	, m_numOpens(0)
+	, m_numReads(0)
+	, m_numRereads(0)
+	, m_bytesRead(0)
+	, m_bytesReread(0)
+	, m_numSeeks(0)
+	, m_numBackwardSeeks(0)
+	, m_numTells(0)
+	, m_readSizes()
+	, m_readFlags(size_t(std::max(size, 0L)), false)
+	, m_bytesCovered(0)
+{
+	for (auto &num : m_readSizes) num=0;
+}
+
+int TraceData::getReadSizeClass(unsigned long size)
+{
+	if (size<=1) return int(size);
+	int res=2;
+	for (unsigned long maxSize=2; maxSize<size && res<NumReadSizes-1; maxSize*=2)
+		++res;
+	return res;
+}
+
+std::string TraceData::getReadSizeClassName(int sizeClass)
+{
+	if (sizeClass<=2) return std::to_string(sizeClass);
+	if (sizeClass>=NumReadSizes-1) return ">" + std::to_string(1ul<<(NumReadSizes-3));
+	return std::to_string((1ul<<(sizeClass-2))+1) + "-" + std::to_string(1ul<<(sizeClass-1));
+}
+
+////////////////////////////////////////////////////////////
+// Tracer
+////////////////////////////////////////////////////////////
+Tracer::Tracer(char const *logFile)
+	: m_log(nullptr)
+	, m_dataList()
+{
+	if (logFile && !(m_log=fopen(logFile, "w")))
+		fprintf(stderr, "ERROR: can not create the trace file %s\n", logFile);
+}
+
+Tracer::~Tracer()
+{
+	if (m_log) fclose(m_log);
+}
+
+size_t Tracer::open(std::string const &name, long size)
+{
+	if (m_log) fprintf(m_log, "O [%s] size=%ld\n", name.c_str(), size);
+	size_t id=0;
+	for (; id<m_dataList.size(); ++id)
+	{
+		if (m_dataList[id].m_name==name) break;
+	}
+	if (id==m_dataList.size())
+		m_dataList.push_back(TraceData(name, size));
+	++m_dataList[id].m_numOpens;
+	return id;
+}
+
+void Tracer::read(size_t id, long pos, unsigned long numRead)
+{
+	if (id>=m_dataList.size()) return;
+	if (m_log) fprintf(m_log, "R [%s] %ld %lu\n", m_dataList[id].m_name.c_str(), pos, numRead);
+	auto &data=m_dataList[id];
+	++data.m_numReads;
+	++data.m_readSizes[TraceData::getReadSizeClass(numRead)];
+	data.m_bytesRead+=numRead;
+	if (pos<0) return;
+	unsigned long numReread=0;
+	for (auto p=size_t(pos); p<size_t(pos)+numRead && p<data.m_readFlags.size(); ++p)
+	{
+		if (data.m_readFlags[p])
+			++numReread;
+		else
+		{
+			data.m_readFlags[p]=true;
+			++data.m_bytesCovered;
+		}
+	}
+	if (!numReread) return;
+	++data.m_numRereads;
+	data.m_bytesReread+=numReread;
+}
+
+void Tracer::seek(size_t id, long from, long to)
+{
+	if (id>=m_dataList.size()) return;
+	if (m_log) fprintf(m_log, "S [%s] %ld %ld\n", m_dataList[id].m_name.c_str(), from, to);
+	auto &data=m_dataList[id];
+	++data.m_numSeeks;
+	if (to<from) ++data.m_numBackwardSeeks;
+}
+
+void Tracer::tell(size_t id, long pos)
+{
+	if (id>=m_dataList.size()) return;
+	if (m_log) fprintf(m_log, "T [%s] %ld\n", m_dataList[id].m_name.c_str(), pos);
+	++m_dataList[id].m_numTells;
+}
+
+void Tracer::printSummary(FILE *output) const
+{
+	fprintf(output, "%-20s %10s %6s %10s %8s %10s %10s %8s %10s %10s %10s\n", "stream", "size", "opens", "read", "read/size",
+	        "coverage", "reads", "rereads", "reread", "seeks", "backward");
+	for (auto const &data : m_dataList)
+	{
+		fprintf(output, "%-20s %10ld %6lu %10lu %8.2f %9.1f%% %10lu %8lu %10lu %10lu %10lu\n",
+		        data.m_name.empty() ? "[main]" : data.m_name.c_str(), data.m_size, data.m_numOpens, data.m_bytesRead,
+		        data.m_size>0 ? double(data.m_bytesRead)/double(data.m_size) : 0,
+		        data.m_size>0 ? 100*double(data.m_bytesCovered)/double(data.m_size) : 0,
+		        data.m_numReads, data.m_numRereads, data.m_bytesReread, data.m_numSeeks, data.m_numBackwardSeeks);
+	}
+	fprintf(output, "\n%-20s", "read sizes");
+	for (auto const &data : m_dataList)
+		fprintf(output, " %10s", data.m_name.empty() ? "[main]" : data.m_name.substr(0,10).c_str());
+	fprintf(output, "\n");
+	for (int c=0; c<TraceData::NumReadSizes; ++c)
+	{
+		bool find=false;
+		for (auto const &data : m_dataList)
+		{
+			if (data.m_readSizes[c]) find=true;
+		}
+		if (!find) continue;
+		fprintf(output, "%-20s", TraceData::getReadSizeClassName(c).c_str());
+		for (auto const &data : m_dataList)
+			fprintf(output, " %10lu", data.m_readSizes[c]);
+		fprintf(output, "\n");
+	}
+	unsigned long numTells=0;
+	for (auto const &data : m_dataList)
+		numTells+=data.m_numTells;
+	fprintf(output, "\nnumber of tell calls: %lu\n", numTells);
+}
+
+std::string Tracer::getJSONSummary() const
+{
+	std::stringstream s;
+	s << "[";
+	for (size_t i=0; i<m_dataList.size(); ++i)
+	{
+		auto const &data=m_dataList[i];
+		std::string name;
+		for (auto c : data.m_name)
+		{
+			if (c=='"' || c=='\\') name+='\\';
+			else if (static_cast<unsigned char>(c)<0x20) continue;
+			name+=c;
+		}
+		s << (i ? ", " : "") << "{\"stream\": \"" << name << "\", \"size\": " << data.m_size
+		  << ", \"opens\": " << data.m_numOpens << ", \"bytesRead\": " << data.m_bytesRead
+		  << ", \"bytesCovered\": " << data.m_bytesCovered << ", \"reads\": " << data.m_numReads
+		  << ", \"rereads\": " << data.m_numRereads << ", \"bytesReread\": " << data.m_bytesReread
+		  << ", \"seeks\": " << data.m_numSeeks << ", \"backwardSeeks\": " << data.m_numBackwardSeeks
+		  << ", \"tells\": " << data.m_numTells << ", \"readSizes\": {";
+		bool first=true;
+		for (int c=0; c<TraceData::NumReadSizes; ++c)
+		{
+			if (!data.m_readSizes[c]) continue;
+			s << (first ? "" : ", ") << "\"" << TraceData::getReadSizeClassName(c) << "\": " << data.m_readSizes[c];
+			first=false;
+		}
+		s << "}}";
+	}
+	s << "]";
+	return s.str();
+}
+
+////////////////////////////////////////////////////////////
+// TraceStream
+////////////////////////////////////////////////////////////
+
+//! returns the size of a stream, restores the position
+static long getStreamSize(librevenge::RVNGInputStream &input)
+{
+	long pos=input.tell();
+	if (input.seek(0, librevenge::RVNG_SEEK_END)!=0)
+	{
+		// some structured streams can not seek
+		input.seek(pos, librevenge::RVNG_SEEK_SET);
+		return 0;
+	}
+	long size=input.tell();
+	input.seek(pos, librevenge::RVNG_SEEK_SET);
+	return size;
+}
+
+TraceStream::TraceStream(std::shared_ptr<librevenge::RVNGInputStream> const &input, std::shared_ptr<Tracer> const &tracer, std::string const &name)
+	: librevenge::RVNGInputStream()
+	, m_input(input)
+	, m_tracer(tracer)
+	, m_id(0)
+{
+	m_id=m_tracer->open(name, getStreamSize(*m_input));
+}
+
+TraceStream::~TraceStream()
+{
+}
+
+const unsigned char *TraceStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+	long pos=m_input->tell();
+	auto res=m_input->read(numBytes, numBytesRead);
+	m_tracer->read(m_id, pos, res ? numBytesRead : 0);
+	return res;
+}
+
+long TraceStream::tell()
+{
+	long pos=m_input->tell();
+	m_tracer->tell(m_id, pos);
+	return pos;
+}
+
+int TraceStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+{
+	long pos=m_input->tell();
+	int res=m_input->seek(offset, seekType);
+	m_tracer->seek(m_id, pos, m_input->tell());
+	return res;
+}
+
+bool TraceStream::isEnd()
+{
+	return m_input->isEnd();
+}
+
+bool TraceStream::isStructured()
+{
+	return m_input->isStructured();
+}
+
+unsigned TraceStream::subStreamCount()
+{
+	return m_input->subStreamCount();
+}
+
+const char *TraceStream::subStreamName(unsigned id)
+{
+	return m_input->subStreamName(id);
+}
+
+bool TraceStream::existsSubStream(const char *name)
+{
+	return m_input->existsSubStream(name);
+}
+
+librevenge::RVNGInputStream *TraceStream::getSubStreamByName(const char *name)
+{
+	std::shared_ptr<librevenge::RVNGInputStream> subStream(m_input->getSubStreamByName(name));
+	if (!subStream) return nullptr;
+	return new TraceStream(subStream, m_tracer, name ? name : "");
+}
+
+librevenge::RVNGInputStream *TraceStream::getSubStreamById(unsigned id)
+{
+	std::shared_ptr<librevenge::RVNGInputStream> subStream(m_input->getSubStreamById(id));
+	if (!subStream) return nullptr;
+	char const *name=m_input->subStreamName(id);
+	return new TraceStream(subStream, m_tracer, name ? name : "#"+std::to_string(id));
+}
+}
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,144 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef TRACE_STREAM_H
+#  define TRACE_STREAM_H
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+namespace libwpsHelper
+{
+/** \brief the accesses made to a stream (or to all the sub streams
+	which have the same name) */
+struct TraceData
+{
+	//! the number of read size classes: 0, 1, 2, 3-4, 5-8, ..., >64k
+	static int const NumReadSizes=19;
+	//! constructor
+	TraceData(std::string const &name, long size);
+	//! returns the class of a read size
+	static int getReadSizeClass(unsigned long size);
+	//! returns the name of a read size class
+	static std::string getReadSizeClassName(int sizeClass);
+	//! the stream name ("" for the main stream)
+	std::string m_name;
+	//! the stream size
+	long m_size;
+	//! the number of time the stream is opened
+	unsigned long m_numOpens;
+	//! the number of read calls
+	unsigned long m_numReads;
+	//! the number of read calls which read some already read bytes
+	unsigned long m_numRereads;
+	//! the number of bytes read
+	unsigned long m_bytesRead;
+	//! the number of bytes read which were already read
+	unsigned long m_bytesReread;
+	//! the number of seek calls
+	unsigned long m_numSeeks;
+	//! the number of seek calls which move backward
+	unsigned long m_numBackwardSeeks;
+	//! the number of tell calls
+	unsigned long m_numTells;
+	//! the number of read calls in each size class
+	unsigned long m_readSizes[NumReadSizes];
+	//! a flag for each byte of the stream: true if the byte was read
+	std::vector<bool> m_readFlags;
+	//! the number of different bytes read
+	unsigned long m_bytesCovered;
+};
+
+/** \brief the accesses made to a main stream and its sub streams */
+class Tracer
+{
+public:
+	//! constructor, if logFile is set, each access is written in this file
+	explicit Tracer(char const *logFile=nullptr);
+	//! destructor: closes the log file
+	~Tracer();
+	//! returns the data's index corresponding to a stream, creates it if needed
+	size_t open(std::string const &name, long size);
+	//! registers a read
+	void read(size_t id, long pos, unsigned long numRead);
+	//! registers a seek
+	void seek(size_t id, long from, long to);
+	//! registers a tell
+	void tell(size_t id, long pos);
+	//! returns the data of each stream
+	std::vector<TraceData> const &getData() const
+	{
+		return m_dataList;
+	}
+	//! prints a summary of the accesses
+	void printSummary(FILE *output) const;
+	//! returns a summary of the accesses in JSON format
+	std::string getJSONSummary() const;
+protected:
+	//! the log file
+	FILE *m_log;
+	//! the data of each stream
+	std::vector<TraceData> m_dataList;
+private:
+	Tracer(const Tracer &) = delete; // copy is not allowed
+	Tracer &operator=(const Tracer &) = delete; // assignment is not allowed
+};
+
+/** \brief a input stream which registers all the accesses made to
+	another stream (and to its sub streams) in a tracer */
+class TraceStream final : public librevenge::RVNGInputStream
+{
+public:
+	//! constructor
+	TraceStream(std::shared_ptr<librevenge::RVNGInputStream> const &input, std::shared_ptr<Tracer> const &tracer, std::string const &name="");
+	//! destructor
+	~TraceStream() override;
+	//! returns the tracer
+	std::shared_ptr<Tracer> getTracer() const
+	{
+		return m_tracer;
+	}
+
+	const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead) final;
+	long tell() final;
+	int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType) final;
+	bool isEnd() final;
+
+	bool isStructured() final;
+	unsigned subStreamCount() final;
+	const char *subStreamName(unsigned id) final;
+	bool existsSubStream(const char *name) final;
+	librevenge::RVNGInputStream *getSubStreamByName(const char *name) final;
+	librevenge::RVNGInputStream *getSubStreamById(unsigned id) final;
+private:
+	//! the original stream
+	std::shared_ptr<librevenge::RVNGInputStream> m_input;
+	//! the tracer
+	std::shared_ptr<Tracer> m_tracer;
+	//! the stream index in the tracer
+	size_t m_id;
+
+	TraceStream(const TraceStream &) = delete; // copy is not allowed
+	TraceStream &operator=(const TraceStream &) = delete; // assignment is not allowed
+};
+}
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,177 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cstdlib>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-generators/RVNGDummySpreadsheetGenerator.h>
+#include <librevenge-generators/RVNGDummyTextGenerator.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libwps/libwps.h>
+
+#include "helper.h"
+#include "memoryCounter.h"
+
+using namespace libwps;
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifndef VERSION
+#define VERSION "UNKNOWN VERSION"
+#endif
+
+static int printUsage()
+{
+	printf("`wps-profile' parses a document and reports for each zone of the document the number\n");
+	printf("of zones, their size, the time spent to decode them and the time spent to send\n");
+	printf("their content to the interface.\n");
+	printf("If asked, it also reports the memory allocated by some subsystems: the cells, the styles,\n");
+	printf("the formulas, the OLE streams, the embedded objects and the listener.\n");
+	printf("The report is written in JSON format.\n");
+	printf("\n");
+	printf("Usage: wps-profile [OPTION] FILE...\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("\t-e ENCODING        define the file encoding, see wps2text -h\n");
+	printf("\t-h                 show this help message\n");
+	printf("\t-m                 report the memory allocated by each subsystem\n");
+	printf("\t-n NUM             parse each file NUM times\n");
+	printf("\t-o OUTPUT          write the report in OUTPUT instead of the standard output\n");
+	printf("\t-p PASSWORD        set password to open the file\n");
+	printf("\t-v                 show version information\n");
+	printf("\n");
+	printf("Report bugs to <https://sourceforge.net/p/libwps/bugs/> or <https://bugs.documentfoundation.org/>.\n");
+	return -1;
+}
+
+static int printVersion()
+{
+	printf("wps-profile %s\n", VERSION);
+	return 0;
+}
+
+static WPSResult parseFile(char const *file, WPSParseOptions const &options, char const *password, char const *encoding)
+{
+	WPSConfidence confidence;
+	WPSKind kind;
+	bool needCharEncoding;
+	auto input=libwpsHelper::isSupported(file, confidence, kind, needCharEncoding);
+	if (!input || confidence == WPS_CONFIDENCE_NONE)
+	{
+		fprintf(stderr, "ERROR: %s: Unsupported file format!\n", file);
+		return WPS_UNKNOWN_ERROR;
+	}
+	try
+	{
+		if (kind == WPS_TEXT)
+		{
+			librevenge::RVNGDummyTextGenerator listenerImpl;
+			return WPSDocument::parse(input.get(), &listenerImpl, options, password, encoding);
+		}
+		librevenge::RVNGDummySpreadsheetGenerator listenerImpl;
+		return WPSDocument::parse(input.get(), &listenerImpl, options, password, encoding);
+	}
+	catch (...)
+	{
+	}
+	return WPS_PARSE_ERROR;
+}
+
+int main(int argc, char *argv[])
+{
+	bool printHelp=false;
+	int ch;
+	char const *encoding="";
+	char const *password=nullptr;
+	char const *output=nullptr;
+	int numParsing=1;
+
+	while ((ch = getopt(argc, argv, "e:hmn:o:p:v")) != -1)
+	{
+		switch (ch)
+		{
+		case 'e':
+			encoding=optarg;
+			break;
+		case 'm':
+			libwpsHelper::setAllocationHooks(&WPSParseProfile::memoryAllocated, &WPSParseProfile::memoryFreed);
+			break;
+		case 'n':
+			numParsing=std::atoi(optarg);
+			break;
+		case 'o':
+			output=optarg;
+			break;
+		case 'p':
+			password=optarg;
+			break;
+		case 'v':
+			printVersion();
+			return 0;
+		default:
+		case 'h':
+			printHelp = true;
+			break;
+		}
+	}
+	if (argc < 1+optind || numParsing<=0 || printHelp)
+	{
+		printUsage();
+		return -1;
+	}
+
+	WPSParseProfile profile;
+	WPSParseOptions options;
+	options.m_profile=&profile;
+	bool ok=true;
+	for (int f=optind; f<argc; ++f)
+	{
+		for (int i=0; i<numParsing; ++i)
+		{
+			auto error=parseFile(argv[f], options, password, encoding);
+			if (error==WPS_OK)
+				continue;
+			fprintf(stderr, "%s: ", argv[f]);
+			libwpsHelper::checkErrorAndPrintMessage(error);
+			ok=false;
+			break;
+		}
+	}
+
+	auto json=profile.getJSON();
+	if (!output)
+		printf("%s", json.cstr());
+	else
+	{
+		FILE *file=fopen(output, "w");
+		if (!file)
+		{
+			fprintf(stderr, "ERROR: can not open %s\n", output);
+			return 1;
+		}
+		fprintf(file, "%s", json.cstr());
+		fclose(file);
+	}
+	return ok ? 0 : 1;
+}
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
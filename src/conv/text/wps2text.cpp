@@ -23,6 +23,9 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <memory>
+#include <vector>
+
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
 #include <librevenge-stream/librevenge-stream.h>
@@ -30,6 +33,7 @@
 #include <libwps/libwps.h>
 
 #include "helper.h"
+#include "teeGenerator.h"
 
 using namespace libwps;
 
@@ -57,6 +61,8 @@ static int printUsage()
 	printf("\t\t MacDevanage, MacFarsi, MacGaelic, MacGreek, MacGujarati, MacGurmukhi, MacHebrew,\n");
 	printf("\t\t MacIceland, MacInuit, MacRoman, MacRomanian, MacThai, MacTurkish.\n");
 	printf("\t-h                 show this help message\n");
+	printf("\t-O FORMAT:FILE     add an output, where FORMAT is html or text: the file\n");
+	printf("\t\t is parsed once and converted in all the outputs\n");
 	printf("\t-p PASSWORD        set password to open the file\n");
 	printf("\t-v                 show version information\n");
 	printf("\n");
@@ -76,14 +82,24 @@ int main(int argc, char *argv[])
 	int ch;
 	char const *encoding="";
 	char const *password=nullptr;
+	std::vector<libwpsHelper::OutputRequest> outputs;
+	char const *const outputFormats[]= {"html", "text", nullptr};
 
-	while ((ch = getopt(argc, argv, "e:hp:v")) != -1)
+	while ((ch = getopt(argc, argv, "e:hO:p:v")) != -1)
 	{
 		switch (ch)
 		{
 		case 'e':
 			encoding=optarg;
 			break;
+		case 'O':
+		{
+			libwpsHelper::OutputRequest request;
+			if (!libwpsHelper::parseOutputRequest(optarg, outputFormats, request))
+				return 1;
+			outputs.push_back(request);
+			break;
+		}
 		case 'p':
 			password=optarg;
 			break;
@@ -116,10 +132,25 @@ int main(int argc, char *argv[])
 
 	librevenge::RVNGString document;
 	librevenge::RVNGTextTextGenerator listenerImpl(document);
-	auto error = WPSDocument::parse(&input, &listenerImpl, password, encoding);
+	// the other outputs are filled during the same parsing
+	std::vector<librevenge::RVNGString> documents(outputs.size());
+	std::vector<std::unique_ptr<librevenge::RVNGTextInterface> > generators;
+	libwpsHelper::TextTee tee;
+	tee.addInterface(&listenerImpl);
+	for (size_t i=0; i<outputs.size(); ++i)
+	{
+		generators.push_back(libwpsHelper::createTextGenerator(outputs[i].m_format, documents[i]));
+		tee.addInterface(generators.back().get());
+	}
+	auto error = WPSDocument::parse(&input, tee.size()>1 ? &tee : static_cast<librevenge::RVNGTextInterface *>(&listenerImpl), password, encoding);
 
 	if (libwpsHelper::checkErrorAndPrintMessage(error))
 		return 1;
+	for (size_t i=0; i<outputs.size(); ++i)
+	{
+		if (!libwpsHelper::writeOutput(outputs[i].m_file, documents[i]))
+			return 1;
+	}
 
 	printf("%s", document.cstr());
 
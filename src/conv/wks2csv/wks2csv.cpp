@@ -27,6 +27,8 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
@@ -35,6 +37,7 @@
 #include <libwps/libwps.h>
 
 #include "helper.h"
+#include "teeGenerator.h"
 
 using namespace libwps;
 
@@ -73,12 +76,16 @@ static int printUsage()
 	printf("\t-F           set to output the formula which exists in the file\n");
 	printf("\t-D FORMAT    set date format: default \"%%m/%%d/%%y\"\n");
 	printf("\t-T FORMAT    set time format: default \"%%H:%%M:%%S\"\n");
+	printf("\t-O FORMAT:FILE add an output, where FORMAT is csv or text: the file\n");
+	printf("\t\t is parsed once and converted in all the outputs\n");
 	printf("\n");
 	printf("Examples:\n");
 	printf("\twks2cvs -d, -D\"%%d/%%m/%%y\" file	convert a file using french locale\n");
 	printf("\n");
 	printf("Note:\n");
 	printf("\tIf -F is present, the formula are generated which english names\n");
+	printf("\tThe csv outputs use the same options and sheet as the main output,\n");
+	printf("\tthe text outputs contain all the sheets\n");
 	printf("\n");
 	printf("Report bugs to <https://sourceforge.net/p/libwps/bugs/> or <https://bugs.documentfoundation.org/>.\n");
 	return -1;
@@ -102,8 +109,10 @@ int main(int argc, char *argv[])
 	int ch;
 	char decSeparator='.', fieldSeparator=',', textSeparator='"';
 	std::string dateFormat("%m/%d/%y"), timeFormat("%H:%M:%S");
+	std::vector<libwpsHelper::OutputRequest> outputs;
+	char const *const outputFormats[]= {"csv", "text", nullptr};
 
-	while ((ch = getopt(argc, argv, "e:hvo:d:f:p:t:D:Nn:FT:")) != -1)
+	while ((ch = getopt(argc, argv, "e:hvo:d:f:p:t:D:Nn:FO:T:")) != -1)
 	{
 		switch (ch)
 		{
@@ -116,6 +125,14 @@ int main(int argc, char *argv[])
 		case 'N':
 			printNumberOfSheet=true;
 			break;
+		case 'O':
+		{
+			libwpsHelper::OutputRequest request;
+			if (!libwpsHelper::parseOutputRequest(optarg, outputFormats, request))
+				return 1;
+			outputs.push_back(request);
+			break;
+		}
 		case 'T':
 			timeFormat=optarg;
 			break;
@@ -167,13 +184,31 @@ int main(int argc, char *argv[])
 
 	WPSResult error=WPS_OK;
 	librevenge::RVNGStringVector vec;
+	// the other outputs are filled during the same parsing
+	std::vector<librevenge::RVNGStringVector> sheets(outputs.size());
 
 	try
 	{
 		librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
 		listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
 		listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
-		error= WPSDocument::parse(input.get(), &listenerImpl, password, encoding);
+		std::vector<std::unique_ptr<librevenge::RVNGSpreadsheetInterface> > generators;
+		libwpsHelper::SpreadsheetTee tee;
+		tee.addInterface(&listenerImpl);
+		for (size_t i=0; i<outputs.size(); ++i)
+		{
+			if (outputs[i].m_format=="csv")
+			{
+				auto *csv=new librevenge::RVNGCSVSpreadsheetGenerator(sheets[i], generateFormula);
+				csv->setSeparators(fieldSeparator, textSeparator, decSeparator);
+				csv->setDTFormats(dateFormat.c_str(),timeFormat.c_str());
+				generators.push_back(std::unique_ptr<librevenge::RVNGSpreadsheetInterface>(csv));
+			}
+			else
+				generators.push_back(std::unique_ptr<librevenge::RVNGSpreadsheetInterface>(new librevenge::RVNGTextSpreadsheetGenerator(sheets[i])));
+			tee.addInterface(generators.back().get());
+		}
+		error= WPSDocument::parse(input.get(), tee.size()>1 ? &tee : static_cast<librevenge::RVNGSpreadsheetInterface *>(&listenerImpl), password, encoding);
 	}
 	catch (...)
 	{
@@ -193,6 +228,33 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
+	for (size_t i=0; i<outputs.size(); ++i)
+	{
+		librevenge::RVNGString data;
+		if (outputs[i].m_format=="csv")
+		{
+			if (sheetToConvert<=(int) sheets[i].size())
+				data.append(sheets[i][sheetToConvert>0 ? unsigned(sheetToConvert-1) : 0]);
+			data.append("\n");
+		}
+		else
+		{
+			for (unsigned sheet=0; sheet<sheets[i].size(); ++sheet)
+			{
+				if (sheet)
+				{
+					librevenge::RVNGString header;
+					header.sprintf("\n\t############# Sheet %d ################\n\n", int(sheet+1));
+					data.append(header);
+				}
+				data.append(sheets[i][sheet]);
+				data.append("\n");
+			}
+		}
+		if (!libwpsHelper::writeOutput(outputs[i].m_file, data))
+			return 1;
+	}
+
 	if (printNumberOfSheet)
 	{
 		std::cout << vec.size() << "\n";
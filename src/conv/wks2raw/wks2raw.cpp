@@ -24,13 +24,20 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
 #include <librevenge-stream/librevenge-stream.h>
 
 #include <libwps/libwps.h>
 
+#include "eventLog.h"
 #include "helper.h"
+#include "teeGenerator.h"
+#include "traceStream.h"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -50,8 +57,14 @@ static int printUsage()
 	printf("Options:\n");
 	printf("\t-h, --help                 show this help message\n");
 	printf("\t-v, --version              show version information\n");
+	printf("\t--cache DIR                replay the event log of FILE stored in DIR if it exists,\n");
+	printf("\t                           otherwise parse FILE and store its event log in DIR\n");
 	printf("\t--callgraph                display the call graph nesting level\n");
 	printf("\t--password PASSWORD        set password to open the file\n");
+	printf("\t--record LOG               also record the parsing events in the file LOG\n");
+	printf("\t--replay                   FILE is an event log: replay it instead of parsing a document\n");
+	printf("\t--trace                    print a summary of the accesses to the file\n");
+	printf("\t--trace-log FILE           write each access to the file in FILE (and print the summary)\n");
 	printf("\n");
 	printf("Report bugs to <https://sourceforge.net/p/libwps/bugs/> or <https://bugs.documentfoundation.org/>.\n");
 	return -1;
@@ -70,6 +83,11 @@ int main(int argc, char *argv[])
 	bool printIndentLevel = false;
 	char *file = nullptr;
 	char const *password=nullptr;
+	bool trace=false;
+	char const *traceLog=nullptr;
+	char const *recordLog=nullptr;
+	bool replay=false;
+	char const *cacheDir=nullptr;
 
 	for (int arg=1; arg<argc; ++arg)
 	{
@@ -77,6 +95,13 @@ int main(int argc, char *argv[])
 			return printUsage();
 		if (!strcmp(argv[arg], "-v") || !strcmp(argv[arg], "--version"))
 			return printVersion();
+		if (!strcmp(argv[arg], "--cache"))
+		{
+			if (arg+1>=argc)
+				return printUsage();
+			cacheDir=argv[++arg];
+			continue;
+		}
 		if (!strcmp(argv[arg], "--callgraph"))
 		{
 			printIndentLevel = true;
@@ -89,6 +114,31 @@ int main(int argc, char *argv[])
 			password=argv[++arg];
 			continue;
 		}
+		if (!strcmp(argv[arg], "--record"))
+		{
+			if (arg+1>=argc)
+				return printUsage();
+			recordLog=argv[++arg];
+			continue;
+		}
+		if (!strcmp(argv[arg], "--replay"))
+		{
+			replay=true;
+			continue;
+		}
+		if (!strcmp(argv[arg], "--trace"))
+		{
+			trace=true;
+			continue;
+		}
+		if (!strcmp(argv[arg], "--trace-log"))
+		{
+			if (arg+1>=argc)
+				return printUsage();
+			trace=true;
+			traceLog=argv[++arg];
+			continue;
+		}
 		if (file)
 			return printUsage();
 		file = argv[arg];
@@ -96,6 +146,20 @@ int main(int argc, char *argv[])
 	if (!file)
 		return printUsage();
 
+	if (replay)
+	{
+		std::vector<unsigned char> data;
+		if (!libwpsHelper::readEventLog(file, data))
+			return 1;
+		librevenge::RVNGRawSpreadsheetGenerator listenerImpl(printIndentLevel);
+		if (!libwpsHelper::replayEventLog(data, listenerImpl))
+		{
+			fprintf(stderr, "ERROR: bad event log!\n");
+			return 1;
+		}
+		return 0;
+	}
+
 	WPSConfidence confidence;
 	WPSKind kind;
 	bool needCharEncoding;
@@ -105,12 +169,51 @@ int main(int argc, char *argv[])
 		printf("ERROR: Unsupported file format!\n");
 		return 1;
 	}
+	// the events are stored in the cache with a name which depends on the
+	// file content, the password and the library version
+	std::string cacheFile;
+	if (cacheDir)
+	{
+		cacheFile=libwpsHelper::getEventLogCacheFile(cacheDir, *input, std::string(VERSION)+"|"+(password ? password : ""));
+		if (cacheFile.empty())
+			return 1;
+		std::vector<unsigned char> data;
+		if (libwpsHelper::readCachedEventLog(cacheFile, data) && !libwpsHelper::isTextEventLog(data))
+		{
+			librevenge::RVNGRawSpreadsheetGenerator listenerImpl(printIndentLevel);
+			if (!libwpsHelper::replayEventLog(data, listenerImpl))
+			{
+				fprintf(stderr, "ERROR: bad event log!\n");
+				return 1;
+			}
+			if (recordLog && !libwpsHelper::writeEventLog(recordLog, data))
+				return 1;
+			return 0;
+		}
+	}
+	std::shared_ptr<libwpsHelper::Tracer> tracer;
+	if (trace)
+	{
+		// the detection is not traced
+		tracer.reset(new libwpsHelper::Tracer(traceLog));
+		input.reset(new libwpsHelper::TraceStream(input, tracer));
+	}
 
 	librevenge::RVNGRawSpreadsheetGenerator listenerImpl(printIndentLevel);
-	auto error= WPSDocument::parse(input.get(), &listenerImpl, password);
+	libwpsHelper::SpreadsheetEventRecorder recorder;
+	libwpsHelper::SpreadsheetTee tee;
+	tee.addInterface(&listenerImpl);
+	if (recordLog || cacheDir)
+		tee.addInterface(&recorder);
+	auto error= WPSDocument::parse(input.get(), &tee, password);
+	if (tracer) tracer->printSummary(stderr);
 
 	if (libwpsHelper::checkErrorAndPrintMessage(error))
 		return 1;
+	if (recordLog && !libwpsHelper::writeEventLog(recordLog, recorder.getData()))
+		return 1;
+	if (cacheDir && !libwpsHelper::writeCachedEventLog(cacheFile, recorder.getData()))
+		return 1;
 
 	return 0;
 }
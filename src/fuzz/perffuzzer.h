@@ -0,0 +1,383 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef PERFFUZZER_H
+#define PERFFUZZER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include <librevenge-generators/RVNGDummySpreadsheetGenerator.h>
+#include <librevenge-generators/RVNGDummyTextGenerator.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libwps/libwps.h>
+
+/** \file perffuzzer.h
+
+	Some functions used by the performance fuzzers: these fuzzers count the
+	work done to parse an input (the bytes read and the seeks done in the
+	streams, the records read, the cells created and the calls to the
+	interface) and abort when the work per input byte exceeds a ratio, so
+	that the fuzzing finds the inputs which trigger superlinear behaviors.
+
+	The ratio can be changed with the environment variable
+	WPS_FUZZ_WORK_RATIO (default 256).
+ */
+namespace wpsPerfFuzzer
+{
+//! a class used to count the work done during a parsing
+class WorkCounter
+{
+public:
+	//! constructor given the input size
+	explicit WorkCounter(size_t size)
+		: m_limit(0)
+		, m_streamWork(0)
+		, m_numCallbacks(0)
+	{
+		static long const ratio=getRatio();
+		// a minimal work is accepted for the small inputs
+		m_limit=ratio*(long(size)+4096);
+	}
+	//! returns the maximum work
+	long limit() const
+	{
+		return m_limit;
+	}
+	//! adds some work done by the stream: bytes read or seek
+	void addStreamWork(unsigned long num)
+	{
+		m_streamWork+=long(num);
+		if (m_streamWork>m_limit)
+			abort("stream work", m_streamWork);
+	}
+	//! adds a call to the interface
+	void addCallback()
+	{
+		if (++m_numCallbacks>m_limit)
+			abort("interface calls", m_numCallbacks);
+	}
+	//! prints a message and aborts
+	void abort(char const *what, long value) const
+	{
+		fprintf(stderr, "wpsPerfFuzzer: too much work: %s=%ld for a limit of %ld\n", what, value, m_limit);
+		std::abort();
+	}
+protected:
+	//! returns the ratio work per byte
+	static long getRatio()
+	{
+		char const *ratio=std::getenv("WPS_FUZZ_WORK_RATIO");
+		long res=ratio ? std::atol(ratio) : 0;
+		return res>0 ? res : 256;
+	}
+	//! the maximum work
+	long m_limit;
+	//! the number of bytes read and the number of seeks
+	long m_streamWork;
+	//! the number of calls to the interface
+	long m_numCallbacks;
+};
+
+//! an input stream which counts the bytes read and the seeks
+class CountingInputStream final : public librevenge::RVNGInputStream
+{
+public:
+	//! constructor given an input stream which is not owned
+	CountingInputStream(librevenge::RVNGInputStream &input, WorkCounter &counter)
+		: librevenge::RVNGInputStream()
+		, m_ownInput()
+		, m_input(input)
+		, m_counter(counter)
+	{
+	}
+	//! constructor given a sub stream which is owned
+	CountingInputStream(librevenge::RVNGInputStream *input, WorkCounter &counter)
+		: librevenge::RVNGInputStream()
+		, m_ownInput(input)
+		, m_input(*input)
+		, m_counter(counter)
+	{
+	}
+	bool isStructured() override
+	{
+		return m_input.isStructured();
+	}
+	unsigned subStreamCount() override
+	{
+		return m_input.subStreamCount();
+	}
+	const char *subStreamName(unsigned id) override
+	{
+		return m_input.subStreamName(id);
+	}
+	bool existsSubStream(const char *name) override
+	{
+		return m_input.existsSubStream(name);
+	}
+	librevenge::RVNGInputStream *getSubStreamByName(const char *name) override
+	{
+		return wrap(m_input.getSubStreamByName(name));
+	}
+	librevenge::RVNGInputStream *getSubStreamById(unsigned id) override
+	{
+		return wrap(m_input.getSubStreamById(id));
+	}
+	const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead) override
+	{
+		auto res=m_input.read(numBytes, numBytesRead);
+		m_counter.addStreamWork(numBytesRead+1);
+		return res;
+	}
+	int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType) override
+	{
+		m_counter.addStreamWork(1);
+		return m_input.seek(offset, seekType);
+	}
+	long tell() override
+	{
+		return m_input.tell();
+	}
+	bool isEnd() override
+	{
+		return m_input.isEnd();
+	}
+private:
+	//! wraps a sub stream
+	librevenge::RVNGInputStream *wrap(librevenge::RVNGInputStream *input)
+	{
+		if (!input) return nullptr;
+		return new CountingInputStream(input, m_counter);
+	}
+	CountingInputStream(CountingInputStream const &) = delete;
+	CountingInputStream &operator=(CountingInputStream const &) = delete;
+	//! the owned sub stream
+	std::unique_ptr<librevenge::RVNGInputStream> m_ownInput;
+	//! the input
+	librevenge::RVNGInputStream &m_input;
+	//! the work counter
+	WorkCounter &m_counter;
+};
+
+//! a dummy text interface which counts the main calls
+class CountingTextGenerator final : public librevenge::RVNGDummyTextGenerator
+{
+public:
+	//! constructor
+	explicit CountingTextGenerator(WorkCounter &counter)
+		: librevenge::RVNGDummyTextGenerator()
+		, m_counter(counter)
+	{
+	}
+	void openPageSpan(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openHeader(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openFooter(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSection(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openParagraph(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSpan(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openListElement(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openFootnote(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openEndnote(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openComment(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openFrame(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openTable(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openTableRow(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openTableCell(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertCoveredTableCell(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertTab() override
+	{
+		m_counter.addCallback();
+	}
+	void insertSpace() override
+	{
+		m_counter.addCallback();
+	}
+	void insertText(const librevenge::RVNGString &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertLineBreak() override
+	{
+		m_counter.addCallback();
+	}
+	void insertField(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertBinaryObject(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+private:
+	CountingTextGenerator(CountingTextGenerator const &) = delete;
+	CountingTextGenerator &operator=(CountingTextGenerator const &) = delete;
+	//! the work counter
+	WorkCounter &m_counter;
+};
+
+//! a dummy spreadsheet interface which counts the main calls
+class CountingSpreadsheetGenerator final : public librevenge::RVNGDummySpreadsheetGenerator
+{
+public:
+	//! constructor
+	explicit CountingSpreadsheetGenerator(WorkCounter &counter)
+		: librevenge::RVNGDummySpreadsheetGenerator()
+		, m_counter(counter)
+	{
+	}
+	void openPageSpan(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSheet(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSheetRow(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSheetCell(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openChart(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openChartSerie(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openComment(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openFrame(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openParagraph(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void openSpan(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void drawPath(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertTab() override
+	{
+		m_counter.addCallback();
+	}
+	void insertSpace() override
+	{
+		m_counter.addCallback();
+	}
+	void insertText(const librevenge::RVNGString &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertLineBreak() override
+	{
+		m_counter.addCallback();
+	}
+	void insertField(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+	void insertBinaryObject(const librevenge::RVNGPropertyList &) override
+	{
+		m_counter.addCallback();
+	}
+private:
+	CountingSpreadsheetGenerator(CountingSpreadsheetGenerator const &) = delete;
+	CountingSpreadsheetGenerator &operator=(CountingSpreadsheetGenerator const &) = delete;
+	//! the work counter
+	WorkCounter &m_counter;
+};
+
+/** parses an input with a counting interface: Generator must be
+	CountingTextGenerator or CountingSpreadsheetGenerator */
+template <class Generator> void parse(const uint8_t *data, size_t size)
+{
+	WorkCounter counter(size);
+	librevenge::RVNGStringStream stringInput(data, static_cast<unsigned int>(size));
+	CountingInputStream input(stringInput, counter);
+	Generator generator(counter);
+	libwps::WPSParseOptions options;
+	// the records read, the iterations of some in-memory loops (WPSTable) and
+	// the cells created are counted by the library
+	options.m_limits.m_maxRecords=options.m_limits.m_maxCells=counter.limit();
+	if (libwps::WPSDocument::parse(&input, &generator, options)==libwps::WPS_LIMIT_EXCEEDED_ERROR)
+		counter.abort("records or cells", counter.limit());
+}
+}
+
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
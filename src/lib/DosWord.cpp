@@ -237,10 +237,8 @@ WPSColor DosWordParser::color(int clr)
 	}
 }
 
-void DosWordParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
+void DosWordParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch)
 {
-	RVNGInputStreamPtr input = getInput();
-
 	DosWordParserInternal::CHP chp;
 
 	chp.m_hps = 24;
@@ -250,15 +248,7 @@ void DosWordParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 		if (cch > sizeof(chp))
 			cch = sizeof(chp);
 
-		unsigned long read_bytes;
-		const unsigned char *p = input->read(cch, read_bytes);
-		if (read_bytes != cch)
-		{
-			WPS_DEBUG_MSG(("DosWordParser::readCHP failed to read CHP entry\n"));
-			throw (libwps::ParseException());
-		}
-
-		memcpy(&chp, p, cch);
+		memcpy(&chp, data, cch);
 	}
 
 	MSWriteParserInternal::Font font;
@@ -334,10 +324,8 @@ void DosWordParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 	m_fontList.push_back(font);
 }
 
-void DosWordParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
+void DosWordParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch)
 {
-	RVNGInputStreamPtr input = getInput();
-
 	DosWordParserInternal::PAP pap;
 
 	WPS_LE_PUT_GUINT16(&pap.m_dyaLine, 240);
@@ -347,15 +335,7 @@ void DosWordParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 		if (cch > sizeof(pap))
 			cch = sizeof(pap);
 
-		unsigned long read_bytes;
-		const unsigned char *p = input->read(cch, read_bytes);
-		if (read_bytes != cch)
-		{
-			WPS_DEBUG_MSG(("DosWordParser::readPAP failed to read PAP\n"));
-			throw (libwps::ParseException());
-		}
-
-		memcpy(&pap, p, cch);
+		memcpy(&pap, data, cch);
 	}
 
 	auto dxaLeft = int16_t(WPS_LE_GET_GUINT16(&pap.m_dxaLeft));
@@ -56,8 +56,8 @@ private:
 	void readSECT(uint32_t fcSep, uint32_t fcLim);
 	void readSED() final;
 	void readFFNTB() final;
-	void readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch) final;
-	void readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch) final;
+	void readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch) final;
+	void readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch) final;
 	void readSUMD() final;
 	void readFNTB() final;
 
@@ -43,6 +43,8 @@
 #include "WPSHeader.h"
 #include "WPSOLE1Parser.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 #include "WPSStringStream.h"
 #include "WPSTable.h"
@@ -412,7 +414,7 @@ bool LotusParser::createListener(librevenge::RVNGSpreadsheetInterface *interface
 	int numPages=m_state->m_maxSheet+1;
 	if (numPages<=0) numPages=1;
 	for (int i=0; i<numPages; ++i) pageList.push_back(ps);
-	m_listener.reset(new WKSContentListener(pageList, interface));
+	m_listener.reset(new WKSContentListener(pageList, interface, getParseContext()));
 	m_listener->setMetaData(m_state->m_metaData);
 	return true;
 }
@@ -529,8 +531,11 @@ bool LotusParser::createZones()
 	std::shared_ptr<WPSStream> mainStream(new WPSStream(input, ascii()));
 	if (vers>=3)
 	{
-		m_ole1Parser.reset(new WPSOLE1Parser(mainStream));
-		m_ole1Parser->createZones();
+		{
+			WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_OLEStreams);
+			m_ole1Parser.reset(new WPSOLE1Parser(mainStream));
+			m_ole1Parser->createZones();
+		}
 		std::shared_ptr<WPSStream> wkStream=m_ole1Parser->getStreamForName(vers==3 ? "WK3" : "123");
 		if (wkStream)
 		{
@@ -595,6 +600,7 @@ bool LotusParser::readZones(std::shared_ptr<WPSStream> stream)
 		{
 			if (m_state->m_isEncrypted && !m_state->m_isDecoded)
 				throw(libwps::PasswordException());
+			getParseContext()->checkProgress(input);
 		}
 
 		//
@@ -650,6 +656,7 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 {
 	if (!stream)
 		return false;
+	getParseContext()->checkRecord();
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -663,6 +670,7 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "Lotus", (type<<8)|id, 4+sz);
 	f << "Entries(Lotus";
 	if (type) f << std::hex << type << std::dec << "A";
 	f << std::hex << id << std::dec << "E):";
@@ -994,9 +1002,11 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 			break;
 		}
 		case 0x11:
+			if (getParseContext()->skipCharts()) break;
 			ok=isParsed=m_chartParser->readChart(stream);
 			break;
 		case 0x12:
+			if (getParseContext()->skipCharts()) break;
 			ok=isParsed=m_chartParser->readChartName(stream);
 			break;
 		case 0x13:
@@ -1029,6 +1039,7 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 		case 0x26: // comment cell
 		case 0x27: // double8 cell
 		case 0x28: // double8+formula
+			if (id==0x26 && getParseContext()->skipComments()) break;
 			ok=isParsed=m_spreadsheetParser->readCell(stream);
 			break;
 		case 0x1b:
@@ -1132,20 +1143,20 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 			break;
 		}
 		case 0xae:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipStyles()) break;
 			isParsed=m_styleManager->readFMTFontName(stream);
 			break;
 		case 0xaf:
 		case 0xb1:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipStyles()) break;
 			isParsed=m_styleManager->readFMTFontSize(stream);
 			break;
 		case 0xb0:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipStyles()) break;
 			isParsed=m_styleManager->readFMTFontId(stream);
 			break;
 		case 0xb6:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipStyles()) break;
 			isParsed=readFMTStyleName(stream);
 			break;
 		case 0xb8: // always 0101
@@ -1195,23 +1206,23 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 			isParsed=ok=m_spreadsheetParser->readExtraRowFormats(stream);
 			break;
 		case 0xc9:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipGraphics()) break;
 			isParsed=ok=m_graphParser->readZoneBeginC9(stream);
 			break;
 		case 0xca: // a graphic
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipGraphics()) break;
 			isParsed=ok=m_graphParser->readGraphic(stream);
 			break;
 		case 0xcc: // frame of a graphic
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipGraphics()) break;
 			isParsed=ok=m_graphParser->readFrame(stream);
 			break;
 		case 0xd1: // the textbox data
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipGraphics()) break;
 			isParsed=ok=m_graphParser->readTextBoxDataD1(stream);
 			break;
 		case 0xb7:
-			if (m_state->m_inMainContentBlock) break;
+			if (m_state->m_inMainContentBlock || getParseContext()->skipGraphics()) break;
 			isParsed=ok=m_graphParser->readFMTPictName(stream);
 			break;
 		case 0xbf: // variable size, can also contain a name, ...
@@ -1253,6 +1264,7 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 			ok=false;
 			break;
 		}
+		if (getParseContext()->skipGraphics()) break;
 		ok = isParsed=m_graphParser->readGraphZone(stream, m_state->m_actualZoneParentId); // sheetZone.Data0
 		break;
 	case 4:
@@ -1269,6 +1281,7 @@ bool LotusParser::readZone(std::shared_ptr<WPSStream> &stream)
 			ok=false;
 			break;
 		}
+		if (getParseContext()->skipCharts()) break;
 		ok = isParsed=readChartZone(stream);
 		break;
 	case 6:
@@ -1347,6 +1360,18 @@ bool LotusParser::readDataZone(std::shared_ptr<WPSStream> stream)
 	}
 	type = int(libwps::readU16(input));
 	f << "Entries(Data" << std::hex << type << std::dec << "E):";
+	auto const &context=getParseContext();
+	bool skipZone=((type>=0xfa0 && type<0x1000) || type==0x32e7) ? context->skipStyles() :
+	              (type>=0x2328 && type<=0x2410) ? context->skipGraphics() :
+	              (type>=0x2710 && type<=0x2a35) ? context->skipCharts() :
+	              type==0x6590 ? context->skipComments() : false;
+	if (skipZone)
+	{
+		ascFile.addPos(pos);
+		ascFile.addNote(f.str().c_str());
+		input->seek(endPos, librevenge::RVNG_SEEK_SET);
+		return true;
+	}
 	bool isParsed=false, needWriteInAscii=false;
 	sz-=2;
 	int val;
@@ -1840,7 +1865,7 @@ bool LotusParser::readZone1(std::shared_ptr<WPSStream> stream)
 		}
 		// 01[XX][YY]00 where Y is a small even number
 		m_state->m_zone1Stack.push_back(libwps::readU32(input));
-		f << m_state->getZone1StackDebugName();
+		WPS_DEBUG_ANNOTATE(f << m_state->getZone1StackDebugName());
 		break;
 	case 5:
 		f << "stack1[close],";
@@ -1859,14 +1884,14 @@ bool LotusParser::readZone1(std::shared_ptr<WPSStream> stream)
 				f << "###val=" << std::hex << lVal << ",";
 			}
 			if (!m_state->m_zone1Stack.empty()) m_state->m_zone1Stack.pop_back();
-			f << m_state->getZone1StackDebugName();
+			WPS_DEBUG_ANNOTATE(f << m_state->getZone1StackDebugName());
 		}
 		break;
 	// level 1=table, 2=col, 3=row
 	case 0x6: // no data
 		f << "level[open],";
 		m_state->m_actualLevels.push_back(Vec2i(0,0));
-		f << "[" << m_state->getLevelsDebugName() << "],";
+		WPS_DEBUG_ANNOTATE(f << "[" << m_state->getLevelsDebugName() << "],");
 		break;
 	case 0x7: // no data
 		f << "level[close]";
@@ -1878,7 +1903,7 @@ bool LotusParser::readZone1(std::shared_ptr<WPSStream> stream)
 		}
 		else
 			m_state->m_actualLevels.pop_back();
-		f << "[" << m_state->getLevelsDebugName() << "],";
+		WPS_DEBUG_ANNOTATE(f << "[" << m_state->getLevelsDebugName() << "],");
 		break;
 	case 0x9: // appear one time at the beginning of the file, pos~8
 		f << "dimension,";
@@ -1946,6 +1971,7 @@ bool LotusParser::readZone1(std::shared_ptr<WPSStream> stream)
 		}
 		break;
 	case 0xd: // after a line: the coordinate, after a texbox the text
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readGraphDataZone(stream,endPos);
 		break;
 
@@ -2825,7 +2851,7 @@ bool LotusParser::readZone8(std::shared_ptr<WPSStream> stream)
 		}
 		zone[0] = zone[1];
 		zone[1] += int(count);
-		f << "pos=[" << m_state->getLevelsDebugName() << "],";
+		WPS_DEBUG_ANNOTATE(f << "pos=[" << m_state->getLevelsDebugName() << "],");
 		break;
 	}
 	// 1 already done
@@ -34,6 +34,8 @@
 
 #include "WKSContentListener.h"
 #include "WKSSubDocument.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 
 #include "WPSEntry.h"
 #include "WPSFont.h"
@@ -953,6 +955,7 @@ bool LotusGraph::readPictureDefinition(std::shared_ptr<WPSStream> stream, long e
 
 bool LotusGraph::readPictureData(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1011,6 +1014,7 @@ void LotusGraph::sendPicture(LotusGraphInternal::ZoneMac const &zone)
 		WPS_DEBUG_MSG(("LotusGraph::sendPicture: I can not find the listener/picture entry\n"));
 		return;
 	}
+	if (m_mainParser.getParseContext()->skipBinaryData()) return;
 	RVNGInputStreamPtr input=zone.m_stream->m_input;
 	librevenge::RVNGBinaryData data;
 	input->seek(zone.m_pictureEntry.begin(), librevenge::RVNG_SEEK_SET);
@@ -41,6 +41,8 @@
 #include "WPSEntry.h"
 #include "WPSFont.h"
 #include "WPSCell.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 #include "WPSTable.h"
 
@@ -318,9 +320,10 @@ public:
 		}
 		return m_positionToCellMap.find(pos)->second;
 	}
-	//! set the columns size
-	void setColumnWidth(int col, WPSColumnFormat const &format)
+	//! set the columns size, returns the number of created columns
+	int setColumnWidth(int col, WPSColumnFormat const &format)
 	{
+		int numCreated=0;
 		if (col >= int(m_widthCols.size()))
 		{
 			// sanity check
@@ -328,14 +331,16 @@ public:
 			                        m_boundsColsMap.find(col)==m_boundsColsMap.end()))
 			{
 				WPS_DEBUG_MSG(("LotusSpreadsheetInternal::Spreadsheet::setColumnWidth: the column %d seems bad\n", col));
-				return;
+				return 0;
 			}
 			WPSColumnFormat defCol;
 			defCol.m_useOptimalWidth=true;
+			numCreated=col+1-int(m_widthCols.size());
 			m_widthCols.resize(size_t(col)+1, defCol);
 		}
 		m_widthCols[size_t(col)] = format;
 		if (col >= m_numCols) m_numCols=col+1;
+		return numCreated;
 	}
 	//! returns the row size in point
 	WPSRowFormat getRowHeight(int row) const
@@ -1009,7 +1014,10 @@ bool LotusSpreadsheet::readColumnDefinition(std::shared_ptr<WPSStream> stream)
 			f << "##col";
 		}
 		else
+		{
+			m_mainParser.getParseContext()->addCreatedCells(1);
 			sheet.m_boundsColsMap[col]=bound;
+		}
 	}
 	ascFile.addPos(pos);
 	ascFile.addNote(f.str().c_str());
@@ -1060,7 +1068,7 @@ bool LotusSpreadsheet::readColumnSizes(std::shared_ptr<WPSStream> stream)
 	{
 		auto col=int(libwps::readU8(input));
 		auto width=int(libwps::readU8(input)); // width in char, default 12...
-		sheet->setColumnWidth(col, WPSColumnFormat(float(7*width)));
+		m_mainParser.getParseContext()->addCreatedCells(sheet->setColumnWidth(col, WPSColumnFormat(float(7*width))));
 		f << width << "C:col" << col << ",";
 	}
 	f << "],";
@@ -1699,7 +1707,7 @@ bool LotusSpreadsheet::readCellsFormat801(std::shared_ptr<WPSStream> stream, WPS
 				if (subZoneId==0)
 				{
 					WPSColumnFormat format(!isWidthDef ? 72 : vers>=5 ? float(width)/16.f : float(width));
-					sheet.setColumnWidth(c, format);
+					m_mainParser.getParseContext()->addCreatedCells(sheet.setColumnWidth(c, format));
 				}
 				else
 				{
@@ -2108,6 +2116,7 @@ bool LotusSpreadsheet::readCellName(std::shared_ptr<WPSStream> stream)
 
 bool LotusSpreadsheet::readCell(std::shared_ptr<WPSStream> stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input=stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -2165,6 +2174,7 @@ bool LotusSpreadsheet::readCell(std::shared_ptr<WPSStream> stream)
 	else
 		sheet=&m_state->m_spreadsheetList[size_t(sheetId)];
 
+	m_mainParser.getParseContext()->addCreatedCells(1);
 	auto &cell=sheet->getCell(stream->m_input, Vec2i(col, row));
 	switch (type)
 	{
@@ -2194,7 +2204,7 @@ bool LotusSpreadsheet::readCell(std::shared_ptr<WPSStream> stream)
 			}
 			text += c;
 		}
-		f << "\"" << getDebugStringForText(text) << "\",";
+		WPS_DEBUG_ANNOTATE(f << "\"" << getDebugStringForText(text) << "\",");
 		WPSEntry entry;
 		entry.setBegin(begText);
 		entry.setEnd(endPos);
@@ -2925,6 +2935,7 @@ static Functions const s_listFunctions[] =
 bool LotusSpreadsheet::readFormula(WPSStream &stream, long endPos, int sheetId, bool newFormula,
                                    std::vector<WKSContentListener::FormulaInstruction> &formula, std::string &error)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 	int const vers=version();
 	RVNGInputStreamPtr &input=stream.m_input;
 	formula.resize(0);
@@ -2932,7 +2943,7 @@ bool LotusSpreadsheet::readFormula(WPSStream &stream, long endPos, int sheetId,
 	long pos = input->tell();
 	if (endPos - pos < 1) return false;
 
-	std::stringstream f;
+	libwps::DebugStream f;
 	std::vector<std::vector<WKSContentListener::FormulaInstruction> > stack;
 	bool ok = true;
 	while (long(input->tell()) != endPos)
@@ -3331,7 +3342,7 @@ bool LotusSpreadsheet::readNote(std::shared_ptr<WPSStream> stream, long endPos)
 	}
 	std::string text;
 	for (long i=0; i<sz-3; ++i) text+=char(libwps::readU8(input));
-	f << getDebugStringForText(text) << ",";
+	WPS_DEBUG_ANNOTATE(f << getDebugStringForText(text) << ",");
 	ascFile.addPos(pos-6);
 	ascFile.addNote(f.str().c_str());
 	return true;
@@ -38,6 +38,8 @@
 #include "WPSFont.h"
 #include "WPSGraphicShape.h"
 #include "WPSGraphicStyle.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 
 #include "Lotus.h"
@@ -643,6 +645,7 @@ bool LotusStyleManager::getPattern64(int id, WPSGraphicStyle::Pattern &pattern)
 ////////////////////////////////////////////////////////////
 bool LotusStyleManager::readLineStyle(std::shared_ptr<WPSStream> stream, long endPos, int vers)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -743,6 +746,7 @@ bool LotusStyleManager::updateLineStyle(int lineId, WPSGraphicStyle &style) cons
 
 bool LotusStyleManager::readColorStyle(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -907,6 +911,7 @@ bool LotusStyleManager::updateShadowStyle(int colorId, WPSGraphicStyle &style) c
 
 bool LotusStyleManager::readGraphicStyle(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -979,6 +984,7 @@ bool LotusStyleManager::readGraphicStyle(std::shared_ptr<WPSStream> stream, long
 
 bool LotusStyleManager::readGraphicStyleC9(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1104,6 +1110,7 @@ bool LotusStyleManager::updateGraphicStyle(int graphicId, WPSGraphicStyle &style
 
 bool LotusStyleManager::readFontStyleA0(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1182,6 +1189,7 @@ bool LotusStyleManager::readFontStyleA0(std::shared_ptr<WPSStream> stream, long
 
 bool LotusStyleManager::readFontStyleF0(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1293,6 +1301,7 @@ bool LotusStyleManager::updateFontStyle(int fontId, WPSFont &font, libwps_tools_
 
 bool LotusStyleManager::readFormatStyle(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1636,6 +1645,7 @@ bool LotusStyleManager::readCellStyleD2Data(LotusStyleManagerInternal::CellStyle
 
 bool LotusStyleManager::readCellStyleD2(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1766,6 +1776,7 @@ bool LotusStyleManager::readCellStyleD2(std::shared_ptr<WPSStream> stream, long
 
 bool LotusStyleManager::readCellStyleE6(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1953,6 +1964,7 @@ bool LotusStyleManager::readCellStyleE6(std::shared_ptr<WPSStream> stream, long
 
 bool LotusStyleManager::readStyleE6(std::shared_ptr<WPSStream> stream, long endPos)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	if (!stream) return false;
 	RVNGInputStreamPtr &input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -26,14 +26,18 @@
 #include "WPSEntry.h"
 #include "WPSPageSpan.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
 #include "WPSFont.h"
+#include "WPSProfiler.h"
 #include "WPSTextSubDocument.h"
 
 #include "MSWrite.h"
 
 #include <algorithm>
 #include <cstring>
+#include <map>
+#include <string>
 
 namespace MSWriteParserInternal
 {
@@ -554,13 +558,16 @@ void MSWriteParser::getPageStyle(MSWriteParserInternal::Section &sep, WPSPageSpa
 	// - page break style
 }
 
-void MSWriteParser::readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint32_t fcFirst, uint32_t fcLim, unsigned size))
+void MSWriteParser::readFOD(unsigned page, bool paragraph)
 {
 	RVNGInputStreamPtr input = getInput();
 	unsigned fcLim, fc = 0x80;
+	// the index of the property decoded for each property data
+	std::map<std::string, size_t> dataToIdMap;
 
 	for (;;)
 	{
+		getParseContext()->checkRecord();
 		auto const pageBegin=long(page * 0x80);
 
 		if (!checkFilePosition(page * 0x80 + 0x7f))
@@ -568,9 +575,20 @@ void MSWriteParser::readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint3
 			WPS_DEBUG_MSG(("MSWriteParser::readFOD: FOD list is truncated\n"));
 			break;
 		}
+		WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "MSWrite", "FOD", 0x80);
 
-		input->seek(pageBegin + 0x7f, librevenge::RVNG_SEEK_SET);
-		uint8_t cfod = libwps::readU8(input);
+		// read the whole page and decode it in memory
+		unsigned char pageData[0x80];
+		input->seek(pageBegin, librevenge::RVNG_SEEK_SET);
+		unsigned long read_bytes;
+		const unsigned char *p = input->read(0x80, read_bytes);
+		if (!p || read_bytes != 0x80)
+		{
+			WPS_DEBUG_MSG(("MSWriteParser::readFOD: can not read the page %u\n", page));
+			break;
+		}
+		memcpy(pageData, p, 0x80);
+		uint8_t cfod = pageData[0x7f];
 
 		if (cfod > 20)
 		{
@@ -580,15 +598,14 @@ void MSWriteParser::readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint3
 
 		for (unsigned fod = 0; fod < cfod; ++fod)
 		{
-			input->seek(pageBegin + int(fod) * 6 + 4, librevenge::RVNG_SEEK_SET);
-			fcLim = libwps::readU32(input);
-			uint16_t bfProp = libwps::readU16(input);
+			unsigned char const *fodData = pageData + fod * 6 + 4;
+			fcLim = WPS_LE_GET_GUINT32(fodData);
+			uint16_t bfProp = WPS_LE_GET_GUINT16(fodData + 4);
 			unsigned cch = 0;
 
 			if (bfProp < 0x7f - 4)
 			{
-				input->seek(pageBegin + long(bfProp) + 4, librevenge::RVNG_SEEK_SET);
-				cch = libwps::readU8(input);
+				cch = pageData[bfProp + 4];
 
 				// Does it fit on the page
 				if ((bfProp + cch + 4) >= 0x80)
@@ -598,7 +615,39 @@ void MSWriteParser::readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint3
 				}
 			}
 
-			(this->*parseFOD)(fc, fcLim, cch);
+			unsigned char const *prop = cch ? pageData + bfProp + 5 : nullptr;
+			// identical properties are only decoded once
+			std::string const data(prop ? reinterpret_cast<char const *>(prop) : "", cch);
+			auto it = dataToIdMap.find(data);
+			if (paragraph)
+			{
+				if (it != dataToIdMap.end())
+				{
+					MSWriteParserInternal::Paragraph para = m_paragraphList[it->second];
+					para.m_fcFirst = fc;
+					para.m_fcLim = fcLim;
+					m_paragraphList.push_back(para);
+				}
+				else
+				{
+					readPAP(fc, fcLim, prop, cch);
+					if (!m_paragraphList.empty())
+						dataToIdMap[data] = m_paragraphList.size()-1;
+				}
+			}
+			else if (it != dataToIdMap.end())
+			{
+				MSWriteParserInternal::Font font = m_fontList[it->second];
+				font.m_fcFirst = fc;
+				font.m_fcLim = fcLim;
+				m_fontList.push_back(font);
+			}
+			else
+			{
+				readCHP(fc, fcLim, prop, cch);
+				if (!m_fontList.empty())
+					dataToIdMap[data] = m_fontList.size()-1;
+			}
 
 			if (fcLim >= m_fcMac)
 				return;
@@ -609,10 +658,8 @@ void MSWriteParser::readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint3
 	}
 }
 
-void MSWriteParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
+void MSWriteParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch)
 {
-	RVNGInputStreamPtr input = getInput();
-
 	struct MSWriteParserInternal::PAP pap;
 
 	WPS_LE_PUT_GUINT16(&pap.m_dyaLine, 240);
@@ -622,15 +669,7 @@ void MSWriteParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 		if (cch > sizeof(pap))
 			cch = sizeof(pap);
 
-		unsigned long read_bytes;
-		const unsigned char *p = input->read(cch, read_bytes);
-		if (read_bytes != cch)
-		{
-			WPS_DEBUG_MSG(("MSWriteParser::readPAP failed to read PAP\n"));
-			throw (libwps::ParseException());
-		}
-
-		memcpy(&pap, p, cch);
+		memcpy(&pap, data, cch);
 	}
 
 	auto dxaLeft = int16_t(WPS_LE_GET_GUINT16(&pap.m_dxaLeft));
@@ -708,10 +747,8 @@ void MSWriteParser::readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 	m_paragraphList.push_back(para);
 }
 
-void MSWriteParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
+void MSWriteParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch)
 {
-	RVNGInputStreamPtr input = getInput();
-
 	struct MSWriteParserInternal::CHP chp;
 
 	chp.m_hps = 24;
@@ -721,15 +758,7 @@ void MSWriteParser::readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch)
 		if (cch > sizeof(chp))
 			cch = sizeof(chp);
 
-		unsigned long read_bytes;
-		const unsigned char *p = input->read(cch, read_bytes);
-		if (read_bytes != cch)
-		{
-			WPS_DEBUG_MSG(("MSWriteParser::readCHP failed to read CHP entry\n"));
-			throw (libwps::ParseException());
-		}
-
-		memcpy(&chp, p, cch);
+		memcpy(&chp, data, cch);
 	}
 
 	MSWriteParserInternal::Font font;
@@ -925,7 +954,7 @@ std::shared_ptr<WPSContentListener> MSWriteParser::createListener(librevenge::RV
 	}
 
 	return std::shared_ptr<WPSContentListener>
-	       (new WPSContentListener(pageList, interface));
+	       (new WPSContentListener(pageList, interface, getParseContext()));
 }
 
 void MSWriteParser::readText(WPSEntry const &e, MSWriteParserInternal::Paragraph::Location location)
@@ -937,9 +966,11 @@ void MSWriteParser::readText(WPSEntry const &e, MSWriteParserInternal::Paragraph
 	chps = m_fontList.begin();
 	RVNGInputStreamPtr input = getInput();
 	float lastObjectHeight = 0.0;
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "MSWrite", "Text", e.length());
 
 	while (fc < uint32_t(e.end()))
 	{
+		getParseContext()->checkProgress(input);
 		bool skiptab = false;
 
 		while (fc >= paps->m_fcLim)
@@ -1698,7 +1729,7 @@ void MSWriteParser::readStructures()
 
 	input->seek(MSWriteParserInternal::HEADER_W_PNPARA, librevenge::RVNG_SEEK_SET);
 	unsigned pnPara = libwps::readU16(input);
-	readFOD(pnPara, &MSWriteParser::readPAP);
+	readFOD(pnPara, true);
 
 	if (m_paragraphList.empty())
 	{
@@ -1706,7 +1737,7 @@ void MSWriteParser::readStructures()
 		throw (libwps::ParseException());
 	}
 
-	readFOD((m_fcMac + 127) / 128, &MSWriteParser::readCHP);
+	readFOD((m_fcMac + 127) / 128, false);
 	if (m_fontList.empty())
 	{
 		WPS_DEBUG_MSG(("MSWriteParser::parse: failed to read any CHP entries\n"));
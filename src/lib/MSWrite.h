@@ -152,9 +152,12 @@ protected:
 	virtual libwps_tools_win::Font::Type getFileEncoding(libwps_tools_win::Font::Type hint);
 	void readFIB();
 	virtual void readFFNTB();
-	void readFOD(unsigned page, void (MSWriteParser::*parseFOD)(uint32_t fcFirst, uint32_t fcLim, unsigned size));
-	virtual void readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned cch);
-	virtual void readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned cch);
+	//! reads the FOD pages beginning at page: the paragraph properties if paragraph is set or the character properties
+	void readFOD(unsigned page, bool paragraph);
+	//! decodes the cch bytes of a paragraph property and adds it to m_paragraphList
+	virtual void readPAP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch);
+	//! decodes the cch bytes of a character property and adds it to m_fontList
+	virtual void readCHP(uint32_t fcFirst, uint32_t fcLim, unsigned char const *data, unsigned cch);
 	virtual void readSUMD();
 	virtual void readFNTB();
 	virtual void readSED();
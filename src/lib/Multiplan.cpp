@@ -33,12 +33,14 @@
 
 #include "WKSContentListener.h"
 #include "WKSSubDocument.h"
+#include "WPSProfiler.h"
 
 #include "WPSCell.h"
 #include "WPSEntry.h"
 #include "WPSFont.h"
 #include "WPSHeader.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
 #include "WPSStringStream.h"
 #include "WPSTable.h"
 
@@ -124,6 +126,16 @@ struct Zone
 	//! list of position in the zone
 	std::set<int> m_positionsSet;
 };
+//! sets the content of a cell from a decoded shared value: a number or a text
+static void setSharedValue(WKSContentListener::CellContent const &value, WKSContentListener::CellContent &content)
+{
+	content.m_contentType=value.m_contentType;
+	if (value.isValueSet())
+		content.setValue(value.m_value);
+	if (value.m_contentType==value.C_TEXT)
+		content.m_textEntry=value.m_textEntry;
+}
+
 //! the state of MultiplanParser
 struct State
 {
@@ -139,6 +151,7 @@ struct State
 		, m_posToLinkMap()
 		, m_posToNameMap()
 		, m_posToSharedDataSeen()
+		, m_sharedValuesMap()
 
 		, m_password(password)
 		, m_hash(0)
@@ -187,6 +200,8 @@ struct State
 	std::map<int, WKSContentListener::FormulaInstruction> m_posToNameMap;
 	//! a set a shared data already seen
 	std::set<int> m_posToSharedDataSeen;
+	//! the map (shared data position, cell type) to the decoded value: number or text
+	std::map<std::pair<int,int>, WKSContentListener::CellContent> m_sharedValuesMap;
 
 	//! the password (if known)
 	char const *m_password;
@@ -301,12 +316,12 @@ void MultiplanParser::parse(librevenge::RVNGSpreadsheetInterface *documentInterf
 		throw(libwps::ParseException());
 }
 
-std::shared_ptr<WKSContentListener> MultiplanParser::createListener(librevenge::RVNGSpreadsheetInterface *interface)
+std::shared_ptr<WKSContentListener> MultiplanParser::createListener(librevenge::RVNGSpreadsheetInterface *interface) const
 {
 	std::vector<WPSPageSpan> pageList;
 	WPSPageSpan ps;
 	pageList.push_back(ps);
-	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface));
+	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface, getParseContext()));
 }
 
 ////////////////////////////////////////////////////////////
@@ -1045,6 +1060,7 @@ static char const *s_listFunctions[]=
 
 bool MultiplanParser::readFormula(Vec2i const &cellPos, std::vector<WKSContentListener::FormulaInstruction> &formula, long endPos, std::string &error)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 	formula.clear();
 	auto input = getInput();
 	std::vector<std::vector<WKSContentListener::FormulaInstruction> > stack;
@@ -1398,6 +1414,7 @@ static char const *s_listFunctionsV2[]=
 
 bool MultiplanParser::readFormulaV2(Vec2i const &cellPos, std::vector<WKSContentListener::FormulaInstruction> &formula, long endZonePos, std::string &error)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 	formula.clear();
 	auto input = getInput();
 	long pos=input->tell();
@@ -2098,6 +2115,14 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 		WPS_DEBUG_MSG(("MultiplanParser::readSharedData: the pos %d seems bad\n", pos));
 		return false;
 	}
+	// the numbers and the texts do not depend on the cell, so they are only decoded once
+	auto const key=std::make_pair(pos, cellType&3);
+	auto vIt=m_state->m_sharedValuesMap.find(key);
+	if (vIt!=m_state->m_sharedValuesMap.end())
+	{
+		MultiplanParserInternal::setSharedValue(vIt->second, content);
+		return true;
+	}
 	auto input = getInput();
 	long actPos=input->tell();
 	long begPos=entry.begin()+pos;
@@ -2130,6 +2155,7 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 		return false;
 	}
 	bool ok=true;
+	WKSContentListener::CellContent sharedValue;
 	switch (type)
 	{
 	case 0:
@@ -2142,24 +2168,24 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 				ok=false;
 			else
 			{
-				content.m_contentType=content.C_NUMBER;
-				content.setValue(value);
+				sharedValue.m_contentType=sharedValue.C_NUMBER;
+				sharedValue.setValue(value);
 				f << value << ",";
 			}
 			break;
 		}
 		case 1:
 		{
-			content.m_contentType=content.C_TEXT;
-			content.m_textEntry.setBegin(input->tell());
-			content.m_textEntry.setLength(dSz);
+			sharedValue.m_contentType=sharedValue.C_TEXT;
+			sharedValue.m_textEntry.setBegin(input->tell());
+			sharedValue.m_textEntry.setLength(dSz);
 			std::string name;
 			for (int c=0; c<dSz; ++c)
 			{
 				char ch=char(libwps::readU8(input));
 				if (vers>=2 && ch==0 && c+1==dSz)
 				{
-					content.m_textEntry.setEnd(input->tell()-1);
+					sharedValue.m_textEntry.setEnd(input->tell()-1);
 					break;
 				}
 				name+=ch;
@@ -2174,8 +2200,8 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 			{
 				f << "Nan" << libwps::readU8(input) << ",";
 				input->seek(7, librevenge::RVNG_SEEK_CUR);
-				content.m_contentType=content.C_NUMBER;
-				content.setValue(std::nan(""));
+				sharedValue.m_contentType=sharedValue.C_NUMBER;
+				sharedValue.setValue(std::nan(""));
 			}
 			break;
 		case 3:
@@ -2185,8 +2211,8 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 			else
 			{
 				val=int(libwps::readU8(input));
-				content.m_contentType=content.C_NUMBER;
-				content.setValue(val);
+				sharedValue.m_contentType=sharedValue.C_NUMBER;
+				sharedValue.setValue(val);
 				if (val==0)
 					f << "false,";
 				else if (val==1)
@@ -2220,6 +2246,11 @@ bool MultiplanParser::readSharedData(int pos, int cellType, Vec2i const &cellPos
 		WPS_DEBUG_MSG(("MultiplanParser::readSharedData: can not read data for the pos %d\n", pos));
 		f << "###";
 	}
+	else if (type==0)
+	{
+		MultiplanParserInternal::setSharedValue(sharedValue, content);
+		m_state->m_sharedValuesMap[key]=sharedValue;
+	}
 	if (m_state->m_posToSharedDataSeen.find(pos)==m_state->m_posToSharedDataSeen.end())
 	{
 		m_state->m_posToSharedDataSeen.insert(pos);
@@ -2305,6 +2336,8 @@ bool MultiplanParser::readZoneB()
 ////////////////////////////////////////////////////////////
 bool MultiplanParser::sendCell(Vec2i const &cellPos, int p)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Cells);
+	getParseContext()->checkRecord();
 	if (!m_listener)
 	{
 		WPS_DEBUG_MSG(("MultiplanParser::sendCell: I can not find the m_listener\n"));
@@ -2670,7 +2703,7 @@ bool MultiplanParser::sendSpreadsheet()
 	WPSRowFormat rowFormat(16);
 	rowFormat.m_isMinimalHeight=true;
 	int lastRow=0;
-	for (auto it : m_state->m_cellPositionsMap)
+	for (auto const &it : m_state->m_cellPositionsMap)
 	{
 		int r=it.first;
 		auto const &row = it.second;
@@ -71,7 +71,7 @@ protected:
 	libwps_tools_win::Font::Type getDefaultFontType() const;
 
 	/** creates the main listener */
-	static std::shared_ptr<WKSContentListener> createListener(librevenge::RVNGSpreadsheetInterface *interface);
+	std::shared_ptr<WKSContentListener> createListener(librevenge::RVNGSpreadsheetInterface *interface) const;
 	//! try to send the main spreadsheet
 	bool sendSpreadsheet();
 	//! try to send a cell
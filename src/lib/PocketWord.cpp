@@ -38,6 +38,7 @@
 #include "WPSHeader.h"
 #include "WPSPageSpan.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
 #include "WPSTextSubDocument.h"
 
@@ -169,7 +170,7 @@ std::shared_ptr<WPSContentListener> PocketWordParser::createListener(librevenge:
 	std::vector<WPSPageSpan> pageList;
 	WPSPageSpan ps(m_state->m_pageSpan);
 	pageList.push_back(ps);
-	auto listener=std::make_shared<WPSContentListener>(pageList, interface);
+	auto listener=std::make_shared<WPSContentListener>(pageList, interface, getParseContext());
 	return listener;
 }
 
@@ -226,6 +227,8 @@ bool PocketWordParser::createZones()
 	int lastId=-1;
 	while (checkFilePosition(input->tell()+6))
 	{
+		getParseContext()->checkRecord();
+		getParseContext()->checkProgress(input);
 		long pos=input->tell();
 		int type=libwps::readU16(input);
 		int id=int(libwps::readU16(input));
@@ -1136,8 +1139,8 @@ bool PocketWordParser::readSoundData(WPSEntry const &entry, long pictSize, WPSEm
 	ascii().addPos(pos-6);
 	ascii().addNote(f.str().c_str());
 
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readData(input,(unsigned long)pictSize,data))
+	object=WPSEmbeddedObject(); // checkme: probably better to set media-type="application/vnd.sun.star.media"
+	if (!object.addZone(input,pictSize))
 	{
 		WPS_DEBUG_MSG(("PocketWordParser::readSoundData: can not read the sound\n"));
 		f << "###";
@@ -1145,12 +1148,15 @@ bool PocketWordParser::readSoundData(WPSEntry const &entry, long pictSize, WPSEm
 		ascii().addNote("SndData:###");
 		return true;
 	}
-	object=WPSEmbeddedObject(data); // checkme: probably better to set media-type="application/vnd.sun.star.media"
 
+#ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	object.getData(0, data);
 	static int pictId=0;
 	std::stringstream s;
 	s << "Snd" << ++pictId << ".wav";
 	libwps::Debug::dumpFile(data, s.str().c_str());
+#endif
 	ascii().skipZone(pos, entry.end()-1);
 	return true;
 }
@@ -43,6 +43,8 @@
 #include "WPSOLEParser.h"
 #include "WPSOLEStream.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 #include "WPSStringStream.h"
 
@@ -660,7 +662,7 @@ std::shared_ptr<WKSContentListener> QuattroParser::createListener(librevenge::RV
 	}
 	ps.setPageSpan(numSheet);
 	pageList.push_back(ps);
-	auto listener=std::make_shared<WKSContentListener>(pageList, interface);
+	auto listener=std::make_shared<WKSContentListener>(pageList, interface, getParseContext());
 	listener->setMetaData(m_state->m_metaData);
 	return listener;
 }
@@ -776,6 +778,7 @@ bool QuattroParser::readZones()
 			break;
 		if (m_state->m_isEncrypted && !m_state->m_isDecoded)
 			throw(libwps::PasswordException());
+		getParseContext()->checkProgress(input);
 	}
 
 	//
@@ -819,6 +822,7 @@ bool QuattroParser::readZones()
 
 bool QuattroParser::parseOLEStream(RVNGInputStreamPtr input, std::string const &avoid)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_OLEStreams);
 	if (!input || !input->isStructured())
 	{
 		WPS_DEBUG_MSG(("QuattroParser::parseOLEStream: oops, can not find the input stream\n"));
@@ -834,7 +838,7 @@ bool QuattroParser::parseOLEStream(RVNGInputStreamPtr input, std::string const &
 	});
 	oleParser.parse(input);
 	oleParser.updateMetaData(m_state->m_metaData);
-	auto objectMap=oleParser.getObjectsMap();
+	auto const &objectMap=oleParser.getObjectsMap();
 	std::map<librevenge::RVNGString,WPSEmbeddedObject> nameToObjectsMap;
 	for (auto it : dirToIdMap)
 	{
@@ -868,7 +872,7 @@ bool QuattroParser::parseOLEStream(RVNGInputStreamPtr input, std::string const &
 		}
 	}
 	if (!nameToObjectsMap.empty())
-		m_graphParser->storeObjects(nameToObjectsMap);
+		m_graphParser->storeObjects(std::move(nameToObjectsMap));
 	return true;
 }
 
@@ -934,6 +938,8 @@ bool QuattroParser::readOLEZones(std::shared_ptr<WPSStream> &stream)
 		const unsigned char *data=input->read(static_cast<unsigned long>(sSz), numRead);
 		if (data && long(numRead)==sSz)
 		{
+			// the ole's data and the storage allocation chains are kept in memory
+			getParseContext()->addMemory(sSz);
 			auto ole=libwps_OLE::getOLEInputStream(std::make_shared<WPSStringStream>(data, unsigned(numRead)));
 			if (!ole)
 			{
@@ -969,6 +975,7 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 {
 	if (!stream)
 		return false;
+	getParseContext()->checkRecord();
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -981,6 +988,7 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "Quattro", id, 4+sz);
 
 	if (id&0x8000)
 	{
@@ -1332,15 +1340,18 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 		isParsed=m_spreadsheetParser->readSheetName(stream);
 		break;
 	case 0xce:
+		if (getParseContext()->skipStyles()) break;
 		ok = m_spreadsheetParser->readCellStyle(stream);
 		isParsed = true;
 		break;
 	case 0xcf:
 	case 0xfc:
 	case 0x110:
+		if (getParseContext()->skipStyles()) break;
 		isParsed=readFontDef(stream);
 		break;
 	case 0xd0:
+		if (getParseContext()->skipStyles()) break;
 		isParsed=readStyleName(stream);
 		break;
 	case 0xd1:
@@ -1419,6 +1430,7 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 		break;
 	}
 	case 0xe8:
+		if (getParseContext()->skipStyles()) break;
 		isParsed=readColorList(stream);
 		break;
 	case 0xed:
@@ -1587,14 +1599,17 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 		}
 		break;
 	case 0x2dc:
+		if (getParseContext()->skipCharts()) break;
 		isParsed=readSerieExtension(stream);
 		break;
 	case 0x321:
 	case 0x322:
+		if (getParseContext()->skipGraphics() && getParseContext()->skipCharts()) break;
 		isParsed=m_graphParser->readBeginEnd(stream, m_state->m_actualSheet);
 		break;
 	// case 0x324: a list of XX:20?: seems relative to graph/chart
 	case 0x33e: // oval
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readRect(stream);
 		break;
 	case 0x341: // maybe chart ?
@@ -1613,55 +1628,71 @@ bool QuattroParser::readZone(std::shared_ptr<WPSStream> &stream)
 	case 0x351:
 	case 0x35d:
 	case 0x36d:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readDialogUnknown(stream);
 		break;
 	case 0x35a:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readLine(stream);
 		break;
 	case 0x35b: // polygon
 	case 0x35c: // polyline
 	case 0x37c: // free polyline
 	case 0x388: // free polygon
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readPolygon(stream);
 		break;
 	case 0x35e:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readDialog(stream);
 		break;
 	case 0x364:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readRect(stream);
 		break;
 	case 0x36f:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readTextBox(stream);
 		break;
 	case 0x379: // round rect
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readRect(stream);
 		break;
 	case 0x37b: // arrow
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readLine(stream);
 		break;
 	case 0x381: // frame wb2
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readFrameOLE(stream);
 		break;
 	case 0x382: // only wb2?
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readImage(stream);
 		break;
 	case 0x383: // only wb2?
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readBitmap(stream);
 		break;
 	case 0x384:
+		if (getParseContext()->skipCharts()) break;
 		isParsed = m_graphParser->readChart(stream);
 		break;
 	case 0x385:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readFrame(stream);
 		break;
 	case 0x386:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readButton(stream);
 		break;
 	case 0x38b:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readOLEData(stream);
 		break;
 
 	case 0x4d3: // wb2 and wb3
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readShape(stream);
 		break;
 	default:
@@ -1718,6 +1749,23 @@ bool QuattroParser::readCString(std::shared_ptr<WPSStream> stream, librevenge::R
 	return true;
 }
 
+bool QuattroParser::skipCString(std::shared_ptr<WPSStream> stream, long maxSize)
+{
+	RVNGInputStreamPtr input = stream->m_input;
+	long pos = input->tell();
+	if (!stream->checkFilePosition(pos+maxSize))
+	{
+		WPS_DEBUG_MSG(("QuattroParser::skipCString: string's size seems bad\n"));
+		return false;
+	}
+	if (maxSize<=0) return true;
+	unsigned long numRead;
+	unsigned char const *data=input->read(static_cast<unsigned long>(maxSize), numRead);
+	auto const *end=data ? static_cast<unsigned char const *>(memchr(data, 0, numRead)) : nullptr;
+	input->seek(end ? pos+long(end-data)+1 : pos+maxSize, librevenge::RVNG_SEEK_SET);
+	return true;
+}
+
 bool QuattroParser::readFieldName(std::shared_ptr<WPSStream> stream)
 {
 	RVNGInputStreamPtr input = stream->m_input;
@@ -1841,6 +1889,7 @@ bool QuattroParser::readExternalData(std::shared_ptr<WPSStream> stream)
 
 bool QuattroParser::readFontDef(std::shared_ptr<WPSStream> stream)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -151,6 +151,8 @@ protected:
 	static bool readSerieExtension(std::shared_ptr<WPSStream> stream);
 	//! try to read a basic C string, knowing the maximum size
 	bool readCString(std::shared_ptr<WPSStream> stream, librevenge::RVNGString &string, long maxSize);
+	//! try to skip a basic C string without decoding it, knowing the maximum size
+	static bool skipCString(std::shared_ptr<WPSStream> stream, long maxSize);
 
 	//////////////////////// unknown zone ////////////////////////////////////
 
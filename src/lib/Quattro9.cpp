@@ -43,6 +43,8 @@
 #include "WPSOLEParser.h"
 #include "WPSOLEStream.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 #include "WPSStringStream.h"
 
@@ -586,7 +588,7 @@ std::shared_ptr<WKSContentListener> Quattro9Parser::createListener(librevenge::R
 	if (numSheet<=0) numSheet=1;
 	ps.setPageSpan(numSheet);
 	pageList.push_back(ps);
-	auto listener=std::make_shared<WKSContentListener>(pageList, interface);
+	auto listener=std::make_shared<WKSContentListener>(pageList, interface, getParseContext());
 	listener->setMetaData(m_state->m_metaData);
 	return listener;
 }
@@ -660,6 +662,7 @@ bool Quattro9Parser::readZones()
 			break;
 		if (m_state->m_isEncrypted && !m_state->m_isDecoded)
 			throw(libwps::PasswordException());
+		getParseContext()->checkProgress(input);
 	}
 	if (!input->isEnd())
 	{
@@ -674,6 +677,7 @@ bool Quattro9Parser::readZones()
 
 bool Quattro9Parser::parseOLEStream(RVNGInputStreamPtr input, std::string const &avoid)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_OLEStreams);
 	if (!input || !input->isStructured())
 	{
 		WPS_DEBUG_MSG(("Quattro9Parser::parseOLEStream: oops, can not find the input stream\n"));
@@ -689,7 +693,7 @@ bool Quattro9Parser::parseOLEStream(RVNGInputStreamPtr input, std::string const
 	});
 	oleParser.parse(input);
 	oleParser.updateMetaData(m_state->m_metaData);
-	auto objectMap=oleParser.getObjectsMap();
+	auto const &objectMap=oleParser.getObjectsMap();
 	std::map<librevenge::RVNGString,WPSEmbeddedObject> nameToObjectsMap;
 	for (auto it : dirToIdMap)
 	{
@@ -718,7 +722,7 @@ bool Quattro9Parser::parseOLEStream(RVNGInputStreamPtr input, std::string const
 		}
 	}
 	if (!nameToObjectsMap.empty())
-		m_graphParser->storeObjects(nameToObjectsMap);
+		m_graphParser->storeObjects(std::move(nameToObjectsMap));
 	return true;
 }
 
@@ -726,6 +730,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 {
 	if (!stream)
 		return false;
+	getParseContext()->checkRecord();
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -741,6 +746,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "Quattro9", id, headerSize+sz);
 
 	auto zIt=m_state->m_idToZoneNameMap.find(id);
 	if (zIt==m_state->m_idToZoneNameMap.end())
@@ -911,7 +917,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		{
 			Quattro9ParserInternal::TextEntry entry;
 			if (readPString(stream, pos+headerSize+sz, entry))
-				f << entry.getDebugString(stream) << ",";
+				WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 			else
 			{
 				WPS_DEBUG_MSG(("Quattro9Parser::readZone[user]: can not read a string\n"));
@@ -923,9 +929,11 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		break;
 	}
 	case 0x6:
+		if (getParseContext()->skipStyles()) break;
 		isParsed=readFontNames(stream);
 		break;
 	case 0x7:
+		if (getParseContext()->skipStyles()) break;
 		isParsed=readFontStyles(stream);
 		break;
 	case 0x8:
@@ -965,7 +973,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 			if (val!=fId) f << "id2=" << val << ",";
 			Quattro9ParserInternal::TextEntry entry;
 			if (readPString(stream, pos+headerSize+sz, entry))
-				f << entry.getDebugString(stream) << ",";
+				WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 			else
 			{
 				WPS_DEBUG_MSG(("Quattro9Parser::readZone[style]: can not read a name\n"));
@@ -978,6 +986,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		break;
 	}
 	case 0xa:
+		if (getParseContext()->skipStyles()) break;
 		ok=isParsed=m_spreadsheetParser->readCellStyles(stream);
 		break;
 	case 0xb:
@@ -993,7 +1002,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		else
 		{
 			m_spreadsheetParser->addDLLIdName(val, entry.getString(stream), id==0xb);
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 		}
 		isParsed=needWriteInAscii=true;
 		break;
@@ -1030,7 +1039,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 			f << "###";
 		else
 		{
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 			auto &map = m_state->m_idToExternalFileMap;
 			if (map.find(lId)!=map.end())
 			{
@@ -1067,7 +1076,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 			f << "###";
 		else
 		{
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 			auto &map = m_state->m_idToExternalNameMap;
 			if (map.find(lId)!=map.end())
 			{
@@ -1171,38 +1180,48 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 
 	case 0x1401:
 	case 0x1402:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readBeginEnd(stream, m_state->m_actualSheet);
 		break;
 
 	case 0x2001:
 	case 0x2002:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed = m_graphParser->readBeginEndZone(stream);
 		break;
 
 	case 0x2051:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readGraphHeader(stream);
 		break;
 
 	case 0x2131:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readFrameStyle(stream);
 		break;
 	case 0x2141:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readFramePattern(stream);
 		break;
 	case 0x2171:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readFrameHeader(stream);
 		break;
 	case 0x21d1:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readOLEName(stream);
 		break;
 	case 0x2221:
 	case 0x23d1:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readShape(stream);
 		break;
 	case 0x2371:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readTextboxStyle(stream);
 		break;
 	case 0x2372:
+		if (getParseContext()->skipGraphics()) break;
 		isParsed=m_graphParser->readTextboxText(stream);
 		break;
 
@@ -1216,7 +1235,7 @@ bool Quattro9Parser::readZone(std::shared_ptr<WPSStream> &stream)
 		input->seek(pos+headerSize, librevenge::RVNG_SEEK_SET);
 		Quattro9ParserInternal::TextEntry entry;
 		if (readPString(stream, pos+headerSize+sz, entry))
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 		else
 		{
 			WPS_DEBUG_MSG(("Quattro9Parser::readZone[name]: can not read a string\n"));
@@ -1316,7 +1335,7 @@ bool Quattro9Parser::readFontNames(std::shared_ptr<WPSStream> const &stream)
 		if (readPString(stream, endPos, entry))
 		{
 			font=entry.getString(stream);
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 		}
 		else
 		{
@@ -1335,6 +1354,7 @@ bool Quattro9Parser::readFontNames(std::shared_ptr<WPSStream> const &stream)
 
 bool Quattro9Parser::readFontStyles(std::shared_ptr<WPSStream> const &stream)
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -1583,7 +1603,7 @@ bool Quattro9Parser::readDocumentFields(std::shared_ptr<WPSStream> const &stream
 			ok=false;
 		}
 		else
-			f << entry.getDebugString(stream) << ",";
+			WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 		if (ok && hasRef)
 		{
 			QuattroFormulaInternal::CellReference instr;
@@ -1670,7 +1690,7 @@ bool Quattro9Parser::readDocumentStrings(std::shared_ptr<WPSStream> const &strea
 			break;
 		}
 		entries.push_back(entry);
-		f << entry.getDebugString(stream) << ",";
+		WPS_DEBUG_ANNOTATE(f << entry.getDebugString(stream) << ",");
 		ascFile.addPos(pos);
 		ascFile.addNote(f.str().c_str());
 	}
@@ -27,6 +27,7 @@
 #include <limits>
 #include <map>
 #include <stack>
+#include <utility>
 
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -559,9 +560,9 @@ int Quattro9Graph::version() const
 	return m_state->m_version;
 }
 
-void Quattro9Graph::storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> const &nameToObjectMap)
+void Quattro9Graph::storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> &&nameToObjectMap)
 {
-	m_state->m_linkNameToObjectMap=nameToObjectMap;
+	m_state->m_linkNameToObjectMap=std::move(nameToObjectMap);
 }
 
 bool Quattro9Graph::getColor(int id, WPSColor &color) const
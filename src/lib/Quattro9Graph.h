@@ -77,7 +77,7 @@ protected:
 	//! return the file version
 	int version() const;
 	//! stores the OLE objets
-	void storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> const &nameToObjectMap);
+	void storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> &&nameToObjectMap);
 
 	//! send the page graphic corresponding to a sheet
 	bool sendPageGraphics(int sheetId) const;
@@ -23,12 +23,16 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
+#include <exception>
 #include <limits>
 #include <set>
 #include <sstream>
 #include <stack>
+#include <system_error>
+#include <thread>
 
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -39,7 +43,10 @@
 #include "WKSContentListener.h"
 #include "WPSEntry.h"
 #include "WPSFont.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
+#include "WPSStringStream.h"
 #include "WPSTable.h"
 
 #include "QuattroFormula.h"
@@ -375,15 +382,57 @@ struct CellData
 	std::vector<int> m_flagList;
 };
 
+//! Internal: a cell list zone of Quattro9SpreadsheetInternal which is not yet decoded
+struct CellListZone
+{
+	//! constructor
+	CellListZone(std::shared_ptr<WPSStream> const &stream, long pos, int firstRow, int numCells)
+		: m_stream(stream)
+		, m_pos(pos)
+		, m_input()
+		, m_inputPos(0)
+		, m_size(0)
+		, m_firstRow(firstRow)
+		, m_numCells(numCells)
+	{
+	}
+	//! the file stream (used to store the debug notes)
+	std::shared_ptr<WPSStream> m_stream;
+	//! the file position of the first cell
+	long m_pos;
+	//! the input which contains the cells' data: the file stream or a copy of the data
+	RVNGInputStreamPtr m_input;
+	//! the position of the first cell in m_input
+	long m_inputPos;
+	//! the data size
+	long m_size;
+	//! the first row
+	int m_firstRow;
+	//! the number of cells
+	int m_numCells;
+};
+
 //! Internal: a list of cell and result of Quattro9SpreadsheetInternal
 struct Column
 {
 	//! constructor
-	Column()
-		: m_rowsToCellMap()
+	explicit Column(int col)
+		: m_column(col)
+		, m_rowsToCellMap()
 		, m_rowToCellResMap()
+		, m_cellListZones()
 	{
 	}
+	/** decodes the cell list zones which are not yet decoded. If addNotes is set, the
+		cells are also described in the debug files, which can only be done by the main thread */
+	void decodeCellLists(bool addNotes)
+	{
+		for (auto const &zone : m_cellListZones)
+			decodeCellList(zone, addNotes);
+		std::vector<CellListZone>().swap(m_cellListZones);
+	}
+	//! decodes a cell list zone
+	void decodeCellList(CellListZone const &zone, bool addNotes);
 	//! add a cell/list of cells data
 	void add(Vec2i limits, CellData const &cell)
 	{
@@ -437,12 +486,205 @@ struct Column
 			return &rIt->second;
 		return nullptr;
 	}
+	//! the column
+	int m_column;
 	//! a map rows to cell data
 	std::map<Vec2i, CellData> m_rowsToCellMap;
 	//! a map row to cell result
 	std::map<int, std::pair<std::shared_ptr<WPSStream>, Quattro9ParserInternal::TextEntry> > m_rowToCellResMap;
+	//! the cell list zones which are not yet decoded
+	std::vector<CellListZone> m_cellListZones;
 };
 
+void Column::decodeCellList(CellListZone const &zone, bool addNotes)
+{
+	if (!zone.m_input) return;
+	RVNGInputStreamPtr input=zone.m_input;
+	input->seek(zone.m_inputPos, librevenge::RVNG_SEEK_SET);
+	libwps::DebugFile &ascFile=zone.m_stream->m_ascii;
+	libwps::DebugStream f;
+	long const endPos=zone.m_inputPos+zone.m_size;
+	long const fileDecal=zone.m_pos-zone.m_inputPos;
+	int const col=m_column;
+	int row=zone.m_firstRow;
+	int const lastRow=row+zone.m_numCells;
+	while (input->tell() < endPos)
+	{
+		long const pos=input->tell();
+		f.str("");
+		f << "Spreadsheet[cell]:";
+		CellData cell;
+		int cType=cell.m_type=int(libwps::readU8(input));
+		bool ok=true;
+		if (cType&0x80)
+		{
+			ok=(input->tell()+2<=endPos);
+			if (ok)
+			{
+				cell.m_style=int(libwps::readU16(input));
+				f << "Ce" << cell.m_style-1 << ",";
+			}
+			cType &= 0x7f;
+		}
+		int numData=1, N=1;
+		if (ok)
+		{
+			if ((cType&0x60)==0x40)   // list
+			{
+				ok=(input->tell()+2<=endPos);
+				if (ok)
+				{
+					N=numData=int(libwps::readU16(input));
+					f << "N=" << numData << ",";
+				}
+				cType &= 0x1f;
+			}
+			else if ((cType&0x60)==0x60)   // first value followed by increment value
+			{
+				ok=(input->tell()+2<=endPos);
+				if (ok)
+				{
+					N=int(libwps::readU16(input));
+					f << "serie, N=" << N << ",";
+					numData=2;
+				}
+				cType &= 0x1f;
+			}
+			else if ((cType&0x60)==0x20)
+			{
+				/* CHECKME what is it ?
+				   I tried to generate a list with 2|(n>2) similar values
+				   but it generates a list :-~
+				*/
+				WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Column::decodeCellList: argh, list[cType]=0x20, some cells will be lost\n"));
+				ok=false;
+			}
+		}
+		if (col>=0)
+		{
+			if (N>1)
+				f << "C" << col << "R" << row << "-" << row+N-1 << ",";
+			else
+				f << "C" << col << "R" << row << ",";
+		}
+		cell.m_rows=Vec2i(row, row+N-1);
+		row += N;
+		f << "type=" << std::hex << cType << std::dec << ",";
+		if (ok)
+		{
+			long actPos=input->tell();
+			ok=false;
+			switch (cType)
+			{
+			case 1: // no data?
+				ok=true;
+				break;
+			case 0x2: // unsigned int value
+				if (actPos+numData*2>endPos) break;
+				f << "values=[";
+				for (int i=0; i<numData; ++i)
+				{
+					cell.m_intList.push_back(int(libwps::readU16(input)));
+					f << cell.m_intList.back() << ",";
+				}
+				f << "],";
+				ok=true;
+				break;
+			case 0x3: // signed int
+				if (actPos+numData*2>endPos) break;
+				f << "values=[";
+				for (int i=0; i<numData; ++i)
+				{
+					cell.m_intList.push_back(int(libwps::read16(input)));
+					f << cell.m_intList.back() << ",";
+				}
+				f << "],";
+				ok=true;
+				break;
+			case 4: // double4 value
+				if (actPos+4*numData>endPos || !libwps::readDouble4List(input, size_t(numData), cell.m_doubleList)) break;
+				f << "values=[";
+				for (auto const &value : cell.m_doubleList) f << value << ",";
+				f << "],";
+				ok=true;
+				break;
+			case 5:   // double
+			{
+				if (actPos+numData*8>endPos || !libwps::readDouble8List(input, size_t(numData), cell.m_doubleList)) break;
+				f << "values=[";
+				for (auto const &value : cell.m_doubleList) f << value << ",";
+				f << "],";
+				ok=true;
+				break;
+			}
+			case 7: // string index
+				if (actPos+4*numData>endPos) break;
+				f << "values=[";
+				for (int i=0; i<numData; ++i)   // the ith string
+				{
+					cell.m_intList.push_back(int(libwps::readU32(input)));
+					f << "Str" << cell.m_intList.back() << ",";
+				}
+				f << "],";
+				ok=true;
+				break;
+			case 8: // formula
+				if (actPos+14*numData>endPos) break;
+				f << "values=[";
+				for (int i=0; i<numData; ++i)
+				{
+					double value;
+					bool isNaN;
+					if (libwps::readDouble8(input, value, isNaN))
+						f << value << ",";
+					else
+					{
+						f << "###,";
+						input->seek(actPos+i*14+8, librevenge::RVNG_SEEK_SET);
+						value=0;
+					}
+					cell.m_doubleList.push_back(value);
+					cell.m_flagList.push_back(int(libwps::readU16(input))); // high byte=0-3, lower byte=0|8|10
+					if (cell.m_flagList.back()) f << "fl=" << std::hex << cell.m_flagList.back() << std::dec << ",";
+					cell.m_intList.push_back(int(libwps::readU32(input)));
+					f << "Fo" << cell.m_intList.back() << ",";
+				}
+				f << "],";
+				ok=true;
+				break;
+			default:
+				WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Column::decodeCellList: argh, find unknown type %d, some cells will be lost\n", int(cType)));
+				break;
+			}
+		}
+		if (!ok)
+		{
+			input->seek(pos, librevenge::RVNG_SEEK_SET);
+			break;
+		}
+		if ((cell.m_type&0x9f)!=1) // no need to add cell with no style and no content
+			add(cell.m_rows, cell);
+		if (addNotes)
+		{
+			ascFile.addPos(fileDecal+pos);
+			ascFile.addNote(f.str().c_str());
+		}
+	}
+	if (input->tell() < endPos)
+	{
+		WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Column::decodeCellList: find extra data\n"));
+		if (addNotes)
+		{
+			ascFile.addPos(fileDecal+input->tell());
+			ascFile.addNote("Spreadsheet[cell]:###");
+		}
+	}
+	else if (lastRow!=row)
+	{
+		WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Column::decodeCellList: read an unexpected number of cells %d != %d\n", row, lastRow));
+	}
+}
+
 //! the spreadsheet of a Quattro Spreadsheet
 class Spreadsheet
 {
@@ -453,7 +695,7 @@ public:
 		, m_defaultSizes(1080,260)
 		, m_mergedCellList()
 		, m_colToColumnMap()
-		, m_invalidColumn()
+		, m_invalidColumn(-1)
 	{
 	}
 	//! update the spreadsheet: check for merged cell, ...
@@ -667,8 +909,62 @@ public:
 			WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Spreadsheet::getColumn: called with invalid col=%d\n", col));
 			return m_invalidColumn;
 		}
-		m_colToColumnMap[col]=Column();
-		return m_colToColumnMap.find(col)->second;
+		return m_colToColumnMap.insert(std::make_pair(col, Column(col))).first->second;
+	}
+	/** decodes the cell list zones which are not yet decoded.
+
+		The columns are independent, so if numThreads>1, they are decoded
+		in parallel by a pool of threads (the calling thread included),
+		each thread taking the next column which remains to be decoded.
+	 */
+	void decodeCellLists(int numThreads)
+	{
+		std::vector<CellListZone>().swap(m_invalidColumn.m_cellListZones);
+		std::vector<Column *> columns;
+		for (auto &it : m_colToColumnMap)
+		{
+			if (!it.second.m_cellListZones.empty())
+				columns.push_back(&it.second);
+		}
+		size_t const numWorkers=std::min(size_t(std::max(numThreads,1)), columns.size());
+		if (numWorkers<=1)
+		{
+			for (auto *column : columns) column->decodeCellLists(true);
+			return;
+		}
+		std::atomic<size_t> nextColumn(0);
+		std::vector<std::exception_ptr> exceptions(numWorkers);
+		auto worker=[&columns,&nextColumn](std::exception_ptr &exception)
+		{
+			try
+			{
+				for (size_t c=nextColumn++; c<columns.size(); c=nextColumn++)
+					columns[c]->decodeCellLists(false);
+			}
+			catch (...)
+			{
+				exception=std::current_exception();
+			}
+		};
+		std::vector<std::thread> threads;
+		for (size_t w=1; w<numWorkers; ++w)
+		{
+			try
+			{
+				threads.push_back(std::thread(worker, std::ref(exceptions[w])));
+			}
+			catch (std::system_error const &)
+			{
+				WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::Spreadsheet::decodeCellLists: can not create a new thread\n"));
+				break;
+			}
+		}
+		worker(exceptions[0]);
+		for (auto &thread : threads) thread.join();
+		for (auto const &exception : exceptions)
+		{
+			if (exception) std::rethrow_exception(exception);
+		}
 	}
 	//! returns the list of rows which need to be opened, ...
 	std::set<int> getListSendRow() const
@@ -688,29 +984,6 @@ public:
 		}
 		return rows;
 	}
-	//! returns the list of columns in which a row cell exists
-	std::vector<Vec2i> getListCellsInARow(int row) const
-	{
-		std::vector<Vec2i> cols;
-		CellData const *prevCell=nullptr;
-		int prevCol=-1, numRepeated=0;
-		for (auto const &it : m_colToColumnMap)
-		{
-			auto newCell=it.second.getCell(row);
-			if (it.first==prevCol+numRepeated && prevCell && newCell &&
-			        prevCell->empty() && newCell->empty() && prevCell->m_style==newCell->m_style)
-			{
-				numRepeated++;
-				continue;
-			}
-			if (prevCell) cols.push_back(Vec2i(prevCol,prevCol+numRepeated-1));
-			prevCol=it.first;
-			prevCell=newCell;
-			numRepeated=1;
-		}
-		if (prevCell) cols.push_back(Vec2i(prevCol,prevCol+numRepeated-1));
-		return cols;
-	}
 	//! returns the cell corresponding to a position (if it exist)
 	CellData const *getCell(Vec2i const &pos) const
 	{
@@ -734,6 +1007,141 @@ private:
 	Column m_invalidColumn;
 };
 
+//! Internal: a cell to send in a row and the columns where it is repeated
+struct RowCell
+{
+	//! constructor
+	RowCell(Vec2i const &columns, CellData const *cell)
+		: m_columns(columns)
+		, m_cell(cell)
+	{
+	}
+	//! the first and last columns
+	Vec2i m_columns;
+	//! the cell data
+	CellData const *m_cell;
+};
+
+/** Internal: a class used to transpose the spreadsheet columns in rows.
+
+	The cells are stored by column, so the rows are computed by blocks
+	of consecutive rows: each column is read once per block, from the
+	position where the previous block stopped. Sending a spreadsheet is
+	thus linear in the number of cells and not in rows*columns.
+ */
+class RowCellsIterator
+{
+public:
+	//! constructor
+	RowCellsIterator(Spreadsheet const &sheet, std::vector<int> const &rows)
+		: m_rows(rows)
+		, m_columns()
+		, m_blockBegin(0)
+		, m_blockEnd(0)
+		, m_block()
+	{
+		m_columns.reserve(sheet.m_colToColumnMap.size());
+		for (auto const &it : sheet.m_colToColumnMap)
+		{
+			auto const &cells=it.second.m_rowsToCellMap;
+			if (!cells.empty())
+				m_columns.push_back(ColumnPosition(it.first, cells.begin(), cells.end()));
+		}
+	}
+	//! returns the cells to send in the row m_rows[id]
+	std::vector<RowCell> const &get(size_t id)
+	{
+		if (id<m_blockBegin || id>=m_blockEnd)
+			computeBlock(id);
+		return m_block[id-m_blockBegin];
+	}
+protected:
+	//! the number of rows in a block
+	static size_t const s_blockSize=256;
+	//! the current position in a column
+	struct ColumnPosition
+	{
+		//! constructor
+		ColumnPosition(int col, std::map<Vec2i, CellData>::const_iterator begin, std::map<Vec2i, CellData>::const_iterator end)
+			: m_col(col)
+			, m_begin(begin)
+			, m_it(begin)
+			, m_end(end)
+		{
+		}
+		//! the column
+		int m_col;
+		//! the first cells
+		std::map<Vec2i, CellData>::const_iterator m_begin;
+		//! the current cells
+		std::map<Vec2i, CellData>::const_iterator m_it;
+		//! the end of the column cells
+		std::map<Vec2i, CellData>::const_iterator m_end;
+	};
+	//! computes the block of rows which begins with m_rows[id]
+	void computeBlock(size_t id)
+	{
+		if (id<m_blockBegin)
+		{
+			// the blocks are normally read in increasing order, restart from the beginning
+			WPS_DEBUG_MSG(("Quattro9SpreadsheetInternal::RowCellsIterator::computeBlock: rows are not read in order\n"));
+			for (auto &column : m_columns)
+				column.m_it=column.m_begin;
+		}
+		m_blockBegin=id;
+		m_blockEnd=std::min(id+s_blockSize, m_rows.size());
+		m_block.resize(m_blockEnd-m_blockBegin);
+		for (auto &cells : m_block) cells.clear();
+		if (m_blockBegin>=m_blockEnd) return;
+		auto const rowsBegin=m_rows.begin()+long(m_blockBegin);
+		auto const rowsEnd=m_rows.begin()+long(m_blockEnd);
+		int const firstRow=*rowsBegin, lastRow=*(rowsEnd-1);
+		for (auto &column : m_columns)
+		{
+			auto &it=column.m_it;
+			while (it!=column.m_end && it->first[1]<firstRow) ++it;
+			auto rIt=rowsBegin;
+			while (it!=column.m_end && it->first[0]<=lastRow)
+			{
+				auto const &rows=it->first;
+				rIt=std::lower_bound(rIt, rowsEnd, rows[0]);
+				for (; rIt!=rowsEnd && *rIt<=rows[1]; ++rIt)
+					add(m_block[size_t(rIt-rowsBegin)], column.m_col, it->second);
+				// the cells can continue in the next block
+				if (rows[1]>lastRow) break;
+				++it;
+			}
+		}
+	}
+	//! adds a cell in a row, grouping the consecutive empty cells with the same style
+	static void add(std::vector<RowCell> &cells, int col, CellData const &cell)
+	{
+		if (!cells.empty())
+		{
+			auto &prev=cells.back();
+			if (prev.m_columns[1]+1==col && prev.m_cell->empty() && cell.empty() && prev.m_cell->m_style==cell.m_style)
+			{
+				prev.m_columns[1]=col;
+				return;
+			}
+		}
+		cells.push_back(RowCell(Vec2i(col,col), &cell));
+	}
+	//! the list of rows to send
+	std::vector<int> const &m_rows;
+	//! the current position in each non empty column
+	std::vector<ColumnPosition> m_columns;
+	//! the first row of the block (index in m_rows)
+	size_t m_blockBegin;
+	//! the end of the block (index in m_rows)
+	size_t m_blockEnd;
+	//! the cells to send in each row of the block
+	std::vector<std::vector<RowCell> > m_block;
+private:
+	RowCellsIterator(RowCellsIterator const &) = delete;
+	RowCellsIterator &operator=(RowCellsIterator const &) = delete;
+};
+
 //! the state of Quattro9Spreadsheet
 struct State
 {
@@ -891,6 +1299,7 @@ void Quattro9Spreadsheet::addDocumentStrings(std::shared_ptr<WPSStream> const &s
 ////////////////////////////////////////////////////////////
 bool Quattro9Spreadsheet::readCellStyles(std::shared_ptr<WPSStream> const &stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	int const vers=version();
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
@@ -1347,6 +1756,11 @@ bool Quattro9Spreadsheet::readEndSheet(std::shared_ptr<WPSStream> const &stream)
 		WPS_DEBUG_MSG(("Quattro9Spreadsheet::readEndSheet: the last column is not closed\n"));
 		m_state->m_actualColumn=-1;
 	}
+	if (m_state->m_actualSpreadsheet)
+	{
+		WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
+		m_state->m_actualSpreadsheet->decodeCellLists(m_mainParser.getParseContext()->getNumThreads());
+	}
 	m_state->m_actualSpreadsheet.reset();
 	long filePos[2]; // f0=pointer to a previous zone 601|602
 	Quattro9Parser::readFilePositions(stream, filePos);
@@ -1595,6 +2009,7 @@ bool Quattro9Spreadsheet::readEndColumn(std::shared_ptr<WPSStream> const &stream
 ////////////////////////////////////////////////////////////
 bool Quattro9Spreadsheet::readCellList(std::shared_ptr<WPSStream> const &stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -1617,7 +2032,6 @@ bool Quattro9Spreadsheet::readCellList(std::shared_ptr<WPSStream> const &stream)
 	if (row) f << "first[row]=" << row << ",";
 	int nCells=int(libwps::readU32(input));
 	if (nCells) f << "num[cells]=" << nCells << ",";
-	int lastRow=row+nCells;
 	ascFile.addPos(pos);
 	ascFile.addNote(f.str().c_str());
 
@@ -1626,202 +2040,31 @@ bool Quattro9Spreadsheet::readCellList(std::shared_ptr<WPSStream> const &stream)
 	{
 		WPS_DEBUG_MSG(("Quattro9Spreadsheet::readCellList: call outside a col,begin zone\n"));
 	}
-	Quattro9SpreadsheetInternal::Column invalidColumn;
+	Quattro9SpreadsheetInternal::Column invalidColumn(-1);
 	Quattro9SpreadsheetInternal::Column &column = col>=0 ? m_state->m_actualSpreadsheet->getColumn(col) : invalidColumn;
-	while (input->tell() < endPos)
+	// the cells may be decoded when the sheet is closed, see Spreadsheet::decodeCellLists,
+	// so they are counted now
+	m_mainParser.getParseContext()->addCreatedCells(nCells);
+	Quattro9SpreadsheetInternal::CellListZone zone(stream, input->tell(), row, nCells);
+	if (col<0 || m_mainParser.getParseContext()->getNumThreads()<=1)
+	{
+		// no thread will decode the columns, so decode the cells directly from the file
+		zone.m_input=input;
+		zone.m_inputPos=zone.m_pos;
+		zone.m_size=endPos-zone.m_pos;
+		column.decodeCellList(zone, true);
+	}
+	else
 	{
-		pos=input->tell();
-		f.str("");
-		f << "Spreadsheet[cell]:";
-		Quattro9SpreadsheetInternal::CellData cell;
-		int cType=cell.m_type=int(libwps::readU8(input));
-		bool ok=true;
-		if (cType&0x80)
+		// copy the cells' data, the threads can not share the file stream
+		unsigned long numRead;
+		unsigned char const *data=input->read(static_cast<unsigned long>(endPos-zone.m_pos), numRead);
+		if (data && numRead)
 		{
-			ok=(input->tell()+2<=endPos);
-			if (ok)
-			{
-				cell.m_style=int(libwps::readU16(input));
-				f << "Ce" << cell.m_style-1 << ",";
-			}
-			cType &= 0x7f;
+			zone.m_input.reset(new WPSStringStream(data, static_cast<unsigned int>(numRead)));
+			zone.m_size=long(numRead);
 		}
-		int numData=1, N=1;
-		if (ok)
-		{
-			if ((cType&0x60)==0x40)   // list
-			{
-				ok=(input->tell()+2<=endPos);
-				if (ok)
-				{
-					N=numData=int(libwps::readU16(input));
-					f << "N=" << numData << ",";
-				}
-				cType &= 0x1f;
-			}
-			else if ((cType&0x60)==0x60)   // first value followed by increment value
-			{
-				ok=(input->tell()+2<=endPos);
-				if (ok)
-				{
-					N=int(libwps::readU16(input));
-					f << "serie, N=" << N << ",";
-					numData=2;
-				}
-				cType &= 0x1f;
-			}
-			else if ((cType&0x60)==0x20)
-			{
-				/* CHECKME what is it ?
-				   I tried to generate a list with 2|(n>2) similar values
-				   but it generates a list :-~
-				*/
-				WPS_DEBUG_MSG(("Quattro9Spreadsheet::readCellList: argh, list[cType]=0x20, some cells will be lost\n"));
-				ok=false;
-			}
-		}
-		if (col>=0)
-		{
-			if (N>1)
-				f << "C" << col << "R" << row << "-" << row+N-1 << ",";
-			else
-				f << "C" << col << "R" << row << ",";
-		}
-		cell.m_rows=Vec2i(row, row+N-1);
-		row += N;
-		f << "type=" << std::hex << cType << std::dec << ",";
-		if (ok)
-		{
-			long actPos=input->tell();
-			ok=false;
-			switch (cType)
-			{
-			case 1: // no data?
-				ok=true;
-				break;
-			case 0x2: // unsigned int value
-				if (actPos+numData*2>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)
-				{
-					cell.m_intList.push_back(int(libwps::readU16(input)));
-					f << cell.m_intList.back() << ",";
-				}
-				f << "],";
-				ok=true;
-				break;
-			case 0x3: // signed int
-				if (actPos+numData*2>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)
-				{
-					cell.m_intList.push_back(int(libwps::read16(input)));
-					f << cell.m_intList.back() << ",";
-				}
-				f << "],";
-				ok=true;
-				break;
-			case 4: // double4 value
-				if (actPos+4*numData>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)
-				{
-					double value;
-					bool isNaN;
-					if (libwps::readDouble4(input, value, isNaN))
-						f << value << ",";
-					else
-					{
-						value=0;
-						f << "###,";
-						input->seek(actPos+(i+1)*8, librevenge::RVNG_SEEK_SET);
-					}
-					cell.m_doubleList.push_back(value);
-				}
-				f << "],";
-				ok=true;
-				break;
-			case 5:   // double
-			{
-				if (actPos+numData*8>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)
-				{
-					double value;
-					bool isNaN;
-					if (libwps::readDouble8(input, value, isNaN))
-						f << value << ",";
-					else
-					{
-						value=0;
-						f << "###,";
-						input->seek(actPos+(i+1)*8, librevenge::RVNG_SEEK_SET);
-					}
-					cell.m_doubleList.push_back(value);
-				}
-				f << "],";
-				ok=true;
-				break;
-			}
-			case 7: // string index
-				if (actPos+4*numData>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)   // the ith string
-				{
-					cell.m_intList.push_back(int(libwps::readU32(input)));
-					f << "Str" << cell.m_intList.back() << ",";
-				}
-				f << "],";
-				ok=true;
-				break;
-			case 8: // formula
-				if (actPos+14*numData>endPos) break;
-				f << "values=[";
-				for (int i=0; i<numData; ++i)
-				{
-					double value;
-					bool isNaN;
-					if (libwps::readDouble8(input, value, isNaN))
-						f << value << ",";
-					else
-					{
-						f << "###,";
-						input->seek(actPos+i*14+8, librevenge::RVNG_SEEK_SET);
-						value=0;
-					}
-					cell.m_doubleList.push_back(value);
-					cell.m_flagList.push_back(int(libwps::readU16(input))); // high byte=0-3, lower byte=0|8|10
-					if (cell.m_flagList.back()) f << "fl=" << std::hex << cell.m_flagList.back() << std::dec << ",";
-					cell.m_intList.push_back(int(libwps::readU32(input)));
-					f << "Fo" << cell.m_intList.back() << ",";
-				}
-				f << "],";
-				ok=true;
-				break;
-			default:
-				WPS_DEBUG_MSG(("Quattro9Spreadsheet::readCellList: argh, find unknown type %d, some cells will be lost\n", int(cType)));
-				break;
-			}
-		}
-		if (!ok)
-		{
-			input->seek(pos, librevenge::RVNG_SEEK_SET);
-			break;
-		}
-		if ((cell.m_type&0x9f)!=1) // no need to add cell with no style and no content
-			column.add(cell.m_rows, cell);
-		ascFile.addPos(pos);
-		ascFile.addNote(f.str().c_str());
-	}
-	if (input->tell() < endPos)
-	{
-		WPS_DEBUG_MSG(("Quattro9Spreadsheet::readCellList: find extra data\n"));
-		ascFile.addPos(input->tell());
-		ascFile.addNote("Spreadsheet[cell]:###");
-	}
-	else if (lastRow!=row)
-	{
-		WPS_DEBUG_MSG(("Quattro9Spreadsheet::readCellList: read an unexpected number of cells %d != %d\n", row, lastRow));
+		column.m_cellListZones.push_back(zone);
 	}
 	input->seek(endPos, librevenge::RVNG_SEEK_SET);
 	return true;
@@ -2021,22 +2264,21 @@ void Quattro9Spreadsheet::sendSpreadsheet(int sId)
 		sheet.reset(new Quattro9SpreadsheetInternal::Spreadsheet(sId));
 	else
 		sheet=sheetIt->second;
+	// normally already done when the sheet is closed
+	sheet->decodeCellLists(m_mainParser.getParseContext()->getNumThreads());
 	sheet->update();
 	m_listener->openSheet(sheet->getWidths(), m_state->getSheetName(sId));
 	m_mainParser.sendPageGraphics(sId);
-	std::set<int> listRows=sheet->getListSendRow();
-	for (auto rIt=listRows.begin(); rIt!=listRows.end(); ++rIt)
+	std::set<int> const rowsSet=sheet->getListSendRow();
+	std::vector<int> const listRows(rowsSet.begin(), rowsSet.end());
+	Quattro9SpreadsheetInternal::RowCellsIterator rowCells(*sheet, listRows);
+	for (size_t r=0; r<listRows.size(); ++r)
 	{
-		int row=*rIt;
-		auto nextRIt=rIt;
-		int numRow=(++nextRIt==listRows.end()) ? 1 : *nextRIt-row;
+		int row=listRows[r];
+		int numRow=(r+1==listRows.size()) ? 1 : listRows[r+1]-row;
 		m_listener->openSheetRow(sheet->getRowHeight(row), numRow);
-		std::vector<Vec2i> cols=sheet->getListCellsInARow(row);
-		for (auto const &c : cols)
-		{
-			Vec2i pos(c[0],row);
-			sendCellContent(sheet->getCell(pos), pos, sId, 1+c[1]-c[0]);
-		}
+		for (auto const &c : rowCells.get(r))
+			sendCellContent(c.m_cell, Vec2i(c.m_columns[0],row), sId, 1+c.m_columns[1]-c.m_columns[0]);
 		m_listener->closeSheetRow();
 	}
 	m_listener->closeSheet();
@@ -2111,6 +2353,7 @@ void Quattro9Spreadsheet::sendCellContent(Quattro9SpreadsheetInternal::CellData
 			long actPos=input->tell();
 			std::string error;
 			input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
+			WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 			bool formulaOk=m_state->m_formulaManager.readFormula(stream, entry.end(), pos, sheetId, content.m_formula, error);
 			for (auto const &fo : content.m_formula)
 				f << fo;
@@ -39,6 +39,8 @@
 #include "WPSFont.h"
 #include "WPSHeader.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 
 #include "QuattroDosChart.h"
 #include "QuattroDosSpreadsheet.h"
@@ -354,7 +356,7 @@ std::shared_ptr<WKSContentListener> QuattroDosParser::createListener(librevenge:
 		ps.setHeaderFooter(WPSPageSpan::FOOTER, WPSPageSpan::ALL, subdoc);
 	}
 	pageList.push_back(ps);
-	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface));
+	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface, getParseContext()));
 }
 
 ////////////////////////////////////////////////////////////
@@ -437,7 +439,8 @@ bool QuattroDosParser::readZones()
 {
 	RVNGInputStreamPtr input = getInput();
 	input->seek(0, librevenge::RVNG_SEEK_SET);
-	while (readZone()) ;
+	while (readZone())
+		getParseContext()->checkProgress(input);
 
 	//
 	// look for ending
@@ -470,8 +473,29 @@ bool QuattroDosParser::readZones()
 	return true;
 }
 
+bool QuattroDosParser::isSkippedRecord(int type) const
+{
+	switch (type)
+	{
+	case 0x2d: // graph setting
+	case 0x2e: // named graph setting
+	case 0xb8: // chart type
+	case 0xb9: // chart name
+	case 0xca:
+		return getParseContext()->skipCharts();
+	case 0x9b: // user fonts
+	case 0xc9: // user style
+	case 0xd8: // cell style
+		return getParseContext()->skipStyles();
+	default:
+		break;
+	}
+	return false;
+}
+
 bool QuattroDosParser::readZone()
 {
+	getParseContext()->checkRecord();
 	libwps::DebugStream f;
 	RVNGInputStreamPtr input = getInput();
 	long pos = input->tell();
@@ -490,6 +514,12 @@ bool QuattroDosParser::readZone()
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
+	if (isSkippedRecord(id))
+	{
+		input->seek(pos+4+sz, librevenge::RVNG_SEEK_SET);
+		return true;
+	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "QuattroDos", id, 4+sz);
 
 	f << "Entries(Struct" << std::hex << id << std::dec << "E):";
 	bool ok = true, isParsed = false, needWriteInAscii = false;
@@ -887,6 +917,20 @@ bool QuattroDosParser::readPString(librevenge::RVNGString &string, long maxSize)
 	return true;
 }
 
+bool QuattroDosParser::skipPString(long maxSize)
+{
+	RVNGInputStreamPtr input = getInput();
+	long pos = input->tell();
+	auto sSz=int(libwps::readU8(input));
+	if (sSz>maxSize || !checkFilePosition(pos+1+sSz))
+	{
+		WPS_DEBUG_MSG(("QuattroDosParser::skipPString: string's size seems bad\n"));
+		return false;
+	}
+	input->seek(pos+1+sSz, librevenge::RVNG_SEEK_SET);
+	return true;
+}
+
 bool QuattroDosParser::readUserFonts()
 {
 	libwps::DebugStream f;
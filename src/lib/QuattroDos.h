@@ -102,6 +102,8 @@ protected:
 
 	/** finds the different zones (spreadsheet, chart, print, ...) */
 	bool readZones();
+	//! returns true if a record must be skipped by length without being decoded: chart record when the charts are skipped, ...
+	bool isSkippedRecord(int type) const;
 	//! reads a zone
 	bool readZone();
 
@@ -121,6 +123,8 @@ protected:
 
 	//! try to read a basic pascal string, knowing the maximum size(excluding string size)
 	bool readPString(librevenge::RVNGString &string, long maxSize);
+	//! try to skip a basic pascal string without decoding it, knowing the maximum size(excluding string size)
+	bool skipPString(long maxSize);
 	//////////////////////// unknown zone //////////////////////////////
 
 	//! reads windows record 0:7|0:9
@@ -36,6 +36,8 @@
 #include "WKSContentListener.h"
 #include "WPSEntry.h"
 #include "WPSFont.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSTable.h"
 
 #include "QuattroDos.h"
@@ -313,14 +315,16 @@ public:
 	//! return a cell corresponding to a spreadsheet, create one if needed
 	Cell &getCell(Vec2i const &pos, libwps_tools_win::Font::Type type)
 	{
-		if (m_positionToCellMap.find(pos)==m_positionToCellMap.end())
+		// only one look up: the position is also used to insert the new cell
+		auto it=m_positionToCellMap.lower_bound(pos);
+		if (it==m_positionToCellMap.end() || pos<it->first)
 		{
 			Cell cell(type);
 			cell.setPosition(pos);
-			m_positionToCellMap.insert(std::map<Vec2i, Cell>::value_type(pos,cell));
+			it=m_positionToCellMap.insert(it, std::map<Vec2i, Cell>::value_type(pos,cell));
 		}
 		m_lastCellPos=pos;
-		return m_positionToCellMap.find(pos)->second;
+		return it->second;
 	}
 	//! returns the last cell
 	Cell *getLastCell()
@@ -344,13 +348,19 @@ public:
 		if (maxCol>=int(m_widthCols.size()))
 			m_widthCols.resize(size_t(maxCol+1),-1);
 	}
-	//! set the columns size
-	void setColumnWidth(int col, int w=-1)
+	//! set the columns size, returns the number of created columns
+	int setColumnWidth(int col, int w=-1)
 	{
-		if (col < 0) return;
-		if (col >= int(m_widthCols.size())) m_widthCols.resize(size_t(col)+1, -1);
+		if (col < 0) return 0;
+		int numCreated=0;
+		if (col >= int(m_widthCols.size()))
+		{
+			numCreated=col+1-int(m_widthCols.size());
+			m_widthCols.resize(size_t(col)+1, -1);
+		}
 		m_widthCols[size_t(col)] = w;
 		if (col >= m_numCols) m_numCols=col+1;
+		return numCreated;
 	}
 
 	//! return the columns format
@@ -673,7 +683,7 @@ bool QuattroDosSpreadsheet::readSheetSize()
 	// empty spreadsheet
 	if (nRow==-1 && nCol==0) return true;
 	if (nRow < 0 || nCol <= 0) return false;
-	m_state->getActualSheet().setColumnWidth(nCol-1);
+	m_mainParser.getParseContext()->addCreatedCells(m_state->getActualSheet().setColumnWidth(nCol-1));
 	return true;
 
 }
@@ -749,7 +759,7 @@ bool QuattroDosSpreadsheet::readColumnSize()
 			f << "#col[inc],";
 		}
 		// checkme: unit in character(?) -> TWIP
-		m_state->getActualSheet().setColumnWidth(col, width*105);
+		m_mainParser.getParseContext()->addCreatedCells(m_state->getActualSheet().setColumnWidth(col, width*105));
 	}
 	ascii().addPos(pos);
 	ascii().addNote(f.str().c_str());
@@ -800,6 +810,7 @@ bool QuattroDosSpreadsheet::readHiddenColumns()
 
 bool QuattroDosSpreadsheet::readCellStyle()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	libwps::DebugStream f;
 	long pos = m_input->tell();
 	long type = libwps::read16(m_input);
@@ -988,6 +999,7 @@ bool QuattroDosSpreadsheet::readCellStyle()
 
 bool QuattroDosSpreadsheet::readCellProperty()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	libwps::DebugStream f;
 	long pos = m_input->tell();
 	long type = libwps::read16(m_input);
@@ -1019,7 +1031,10 @@ bool QuattroDosSpreadsheet::readCellProperty()
 		f << "###";
 	}
 	else
+	{
+		m_mainParser.getParseContext()->addCreatedCells(1);
 		cell = &m_state->getActualSheet().getCell(Vec2i(col,row),defFontType);
+	}
 	f << "C" << Vec2i(col,row) << ",";
 	auto flag=int(libwps::readU8(m_input));
 	auto id=int(libwps::readU8(m_input));
@@ -1128,6 +1143,7 @@ bool QuattroDosSpreadsheet::readCellProperty()
 
 bool QuattroDosSpreadsheet::readUserStyle()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	libwps::DebugStream f;
 	long pos = m_input->tell();
 	long type = libwps::read16(m_input);
@@ -1387,6 +1403,7 @@ bool QuattroDosSpreadsheet::readUserStyle()
 
 bool QuattroDosSpreadsheet::readCell()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
 	libwps::DebugStream f;
 
 	long pos = m_input->tell();
@@ -1429,6 +1446,7 @@ bool QuattroDosSpreadsheet::readCell()
 		f << "sheet[id]=" << sheetId << ",";
 	}
 
+	m_mainParser.getParseContext()->addCreatedCells(1);
 	auto &cell=m_state->getActualSheet().getCell(Vec2i(cellPos[0],cellPos[1]), defFontType);
 	cell.m_fileFormat=format;
 	if (!dosFile)
@@ -1507,8 +1525,7 @@ bool QuattroDosSpreadsheet::readCell()
 		else if (align=='\"') cell.setHAlignment(WPSCellFormat::HALIGN_RIGHT);
 		else f << "#align=" << int(align) << ",";
 
-		librevenge::RVNGString text("");
-		if (!m_mainParser.readPString(text,dataSz-2))
+		if (!m_mainParser.skipPString(dataSz-2))
 			f << "##sSz,";
 		else
 		{
@@ -1518,8 +1535,13 @@ bool QuattroDosSpreadsheet::readCell()
 				f << "#extra,";
 				ascii().addDelimiter(m_input->tell(), '|');
 			}
-			if (!text.empty())
-				f << text.cstr() << ",";
+			// the text is only decoded for the debug file
+			WPS_DEBUG_ANNOTATE(
+			    librevenge::RVNGString text("");
+			    m_input->seek(begText-1, librevenge::RVNG_SEEK_SET);
+			    if (m_mainParser.readPString(text,dataSz-2) && !text.empty())
+			        f << text.cstr() << ",";
+			    m_input->seek(endText, librevenge::RVNG_SEEK_SET));
 		}
 		cell.m_content.m_textEntry.setBegin(begText);
 		cell.m_content.m_textEntry.setEnd(endText);
@@ -1599,8 +1621,6 @@ bool QuattroDosSpreadsheet::readCellFormulaResult()
 		WPS_DEBUG_MSG(("QuattroDosSpreadsheet::readCellFormulaResult: the zone seems to short\n"));
 		return false;
 	}
-	long endPos = pos+4+sz;
-
 	bool dosFile = version() <= 1;
 	// skip format for dosFile
 	m_input->seek(dosFile ? pos+5 : pos+4, librevenge::RVNG_SEEK_SET);
@@ -1610,11 +1630,15 @@ bool QuattroDosSpreadsheet::readCellFormulaResult()
 	f << "C" << dim[0] << "x" << dim[1] << ",";
 	// skip format for windows file
 	if (!dosFile) m_input->seek(2, librevenge::RVNG_SEEK_CUR);
-	librevenge::RVNGString text("");
-	if (!m_mainParser.readPString(text,endPos-m_input->tell()-1))
-		f << "##sSz,";
-	else if (!text.empty())
-		f << text.cstr() << ",";
+	// the result is only decoded for the debug file
+	WPS_DEBUG_ANNOTATE(
+	    long const actPos=m_input->tell();
+	    librevenge::RVNGString text("");
+	    if (!m_mainParser.readPString(text,pos+4+sz-actPos-1))
+	        f << "##sSz,";
+	    else if (!text.empty())
+	        f << text.cstr() << ",";
+	    m_input->seek(actPos, librevenge::RVNG_SEEK_SET));
 	ascii().addPos(pos);
 	ascii().addNote(f.str().c_str());
 	return true;
@@ -1856,6 +1880,7 @@ static Functions const s_listFunctions[] =
 bool QuattroDosSpreadsheet::readFormula(long endPos, Vec2i const &position, int sheetId,
                                         std::vector<WKSContentListener::FormulaInstruction> &formula, std::string &error)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 	int const vers=version();
 	formula.resize(0);
 	error = "";
@@ -1939,7 +1964,7 @@ bool QuattroDosSpreadsheet::readFormula(long endPos, Vec2i const &position, int
 		m_input->seek(pos+4+(vers==1 ? 2 : 0), librevenge::RVNG_SEEK_SET);
 		endPos=pos+2+fieldPos[0];
 	}
-	std::stringstream f;
+	libwps::DebugStream f;
 	std::vector<std::vector<WKSContentListener::FormulaInstruction> > stack;
 	bool ok = true;
 	size_t actCellId=0, actDualCellId=size_t(NSingle);
@@ -243,7 +243,7 @@ bool QuattroFormulaManager::readFormula(std::shared_ptr<WPSStream> const &stream
 		input->seek(pos+4, librevenge::RVNG_SEEK_SET);
 		endPos=pos+4+fieldPos;
 	}
-	std::stringstream f;
+	libwps::DebugStream f;
 	std::vector<std::vector<WKSContentListener::FormulaInstruction> > stack;
 	bool ok = true;
 	size_t actCellId=0;
@@ -27,6 +27,7 @@
 #include <limits>
 #include <map>
 #include <stack>
+#include <utility>
 
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -35,6 +36,8 @@
 
 #include "WKSContentListener.h"
 #include "WKSSubDocument.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 
 #include "WPSEntry.h"
 #include "WPSFont.h"
@@ -487,9 +490,9 @@ int QuattroGraph::version() const
 	return m_state->m_version;
 }
 
-void QuattroGraph::storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> const &nameToObjectMap)
+void QuattroGraph::storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> &&nameToObjectMap)
 {
-	m_state->m_linkNameToObjectMap=nameToObjectMap;
+	m_state->m_linkNameToObjectMap=std::move(nameToObjectMap);
 }
 
 std::vector<Vec2i> QuattroGraph::getGraphicCellsInSheet(int sheetId) const
@@ -940,6 +943,7 @@ bool QuattroGraph::readFrameOLE(std::shared_ptr<WPSStream> stream)
 
 bool QuattroGraph::readOLEData(std::shared_ptr<WPSStream> stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -1114,6 +1118,7 @@ bool QuattroGraph::readButton(std::shared_ptr<WPSStream> stream)
 
 bool QuattroGraph::readImage(std::shared_ptr<WPSStream> stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -1175,6 +1180,7 @@ bool QuattroGraph::readImage(std::shared_ptr<WPSStream> stream)
 
 bool QuattroGraph::readBitmap(std::shared_ptr<WPSStream> stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -77,7 +77,7 @@ protected:
 	int version() const;
 
 	//! stores the OLE objets
-	void storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> const &nameToObjectMap);
+	void storeObjects(std::map<librevenge::RVNGString,WPSEmbeddedObject> &&nameToObjectMap);
 	//! return the list of cells containing some graphics in a sheet
 	std::vector<Vec2i> getGraphicCellsInSheet(int sheetId) const;
 	//! send the graphic corresponding to a cell
@@ -38,6 +38,8 @@
 #include "WKSContentListener.h"
 #include "WPSEntry.h"
 #include "WPSFont.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 #include "WPSTable.h"
 
@@ -294,13 +296,19 @@ public:
 	{
 		return m_positionToCellMap.empty();
 	}
-	//! set the columns size
-	void setColumnWidth(int col, int w=-1)
+	//! set the columns size, returns the number of created columns
+	int setColumnWidth(int col, int w=-1)
 	{
-		if (col < 0) return;
-		if (col >= int(m_widthCols.size())) m_widthCols.resize(size_t(col)+1, -1);
+		if (col < 0) return 0;
+		int numCreated=0;
+		if (col >= int(m_widthCols.size()))
+		{
+			numCreated=col+1-int(m_widthCols.size());
+			m_widthCols.resize(size_t(col)+1, -1);
+		}
 		m_widthCols[size_t(col)] = w;
 		if (col >= m_numCols) m_numCols=col+1;
+		return numCreated;
 	}
 
 	//! return the columns format
@@ -487,14 +495,14 @@ struct State
 		, m_idToUserFormatMap()
 	{
 	}
-	//! returns the ith real spreadsheet
-	std::shared_ptr<Spreadsheet> getSheet(int id, libwps_tools_win::Font::Type fontType)
+	//! returns the ith real spreadsheet, the created columns are counted in context
+	std::shared_ptr<Spreadsheet> getSheet(int id, libwps_tools_win::Font::Type fontType, WPSParseContext &context)
 	{
 		auto it=m_spreadsheetMap.find(id);
 		if (it!=m_spreadsheetMap.end())
 			return it->second;
 		std::shared_ptr<Spreadsheet> sheet(new Spreadsheet(id, fontType));
-		sheet->setColumnWidth(m_maxDimension[0]);
+		context.addCreatedCells(sheet->setColumnWidth(m_maxDimension[0]));
 		if (id<0 || id>m_maxDimension[2])
 		{
 			WPS_DEBUG_MSG(("QuattroSpreadsheetInternal::State::getSheet: find unexpected id=%d\n", id));
@@ -627,6 +635,7 @@ void QuattroSpreadsheet::addUserFormat(int id, librevenge::RVNGString const &nam
 ////////////////////////////////////////////////////////////
 bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -659,7 +668,8 @@ bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 		f << "sheet[id]=" << sheetId << ",";
 
 	auto defFontType=m_mainParser.getDefaultFontType();
-	auto sheet = m_state->getSheet(sheetId, defFontType);
+	auto sheet = m_state->getSheet(sheetId, defFontType, *m_mainParser.getParseContext());
+	m_mainParser.getParseContext()->addCreatedCells(1);
 	auto &cell=sheet->getCell(Vec2i(cellPos[0],cellPos[1]), defFontType);
 	auto format=int(libwps::readU16(input));
 	int id=format>>3;
@@ -739,8 +749,7 @@ bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 		else if (align==0x7c) f << "break,"; // FIXME remove "::" in text
 		else if (align) f << "#align=" << int(align) << ",";
 
-		librevenge::RVNGString text("");
-		if (!m_mainParser.readCString(stream,text,dataSz-1))
+		if (!m_mainParser.skipCString(stream,dataSz-1))
 			f << "##sSz,";
 		else
 		{
@@ -752,8 +761,14 @@ bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 			cell.m_stream=stream;
 			cell.m_content.m_textEntry.setBegin(begText);
 			cell.m_content.m_textEntry.setEnd(input->tell()-1);
-			if (!text.empty())
-				f << text.cstr() << ",";
+			// the text is only decoded for the debug file
+			WPS_DEBUG_ANNOTATE(
+			    long const actPos=input->tell();
+			    librevenge::RVNGString text("");
+			    input->seek(begText, librevenge::RVNG_SEEK_SET);
+			    if (m_mainParser.readCString(stream,text,dataSz-1) && !text.empty())
+			        f << text.cstr() << ",";
+			    input->seek(actPos, librevenge::RVNG_SEEK_SET));
 		}
 		break;
 	}
@@ -777,6 +792,7 @@ bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 				f << "],";
 			}
 			std::string error;
+			WPSProfiler::Memory profileFormulaMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 			if (!m_state->m_formulaManager.readFormula(stream, endPos, cell.position(), sheetId, cell.m_content.m_formula, error))
 			{
 				cell.m_content.m_contentType=WKSContentListener::CellContent::C_NUMBER;
@@ -809,6 +825,7 @@ bool QuattroSpreadsheet::readCell(std::shared_ptr<WPSStream> const &stream)
 
 bool QuattroSpreadsheet::readCellStyle(std::shared_ptr<WPSStream> const &stream)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	RVNGInputStreamPtr input = stream->m_input;
 	libwps::DebugFile &ascFile=stream->m_ascii;
 	libwps::DebugStream f;
@@ -1112,7 +1129,7 @@ bool QuattroSpreadsheet::readColumnRowDefaultSize(std::shared_ptr<WPSStream> con
 	if (type==0xd2 || type==0xd4)
 	{
 		auto defFontType=m_mainParser.getDefaultFontType();
-		auto sheet=m_state->getSheet(m_state->m_actSheet, defFontType);
+		auto sheet=m_state->getSheet(m_state->m_actSheet, defFontType, *m_mainParser.getParseContext());
 		if (type==0xd2)
 			sheet->m_heightDefault=float(val)/20.f;
 		else
@@ -1147,7 +1164,7 @@ bool QuattroSpreadsheet::readColumnSize(std::shared_ptr<WPSStream> const &stream
 	int width = libwps::readU16(input);
 
 	auto defFontType=m_mainParser.getDefaultFontType();
-	auto sheet=m_state->getSheet(m_state->m_actSheet, defFontType);
+	auto sheet=m_state->getSheet(m_state->m_actSheet, defFontType, *m_mainParser.getParseContext());
 	bool ok = col >= 0 && col < sheet->m_numCols+10;
 	f << "Col" << col << ":";
 	if (width&0x8000)
@@ -1168,7 +1185,7 @@ bool QuattroSpreadsheet::readColumnSize(std::shared_ptr<WPSStream> const &stream
 			}
 			f << "#col[inc],";
 		}
-		sheet->setColumnWidth(col, width);
+		m_mainParser.getParseContext()->addCreatedCells(sheet->setColumnWidth(col, width));
 	}
 	else if (col>256 && type==0xd8)
 		f << "###,";
@@ -1212,7 +1229,7 @@ bool QuattroSpreadsheet::readRowSize(std::shared_ptr<WPSStream> const &stream)
 		if (row>=0 && m_state->m_actSheet>=0)
 		{
 			auto defFontType=m_mainParser.getDefaultFontType();
-			m_state->getSheet(m_state->m_actSheet, defFontType)->setRowHeight(row, height);
+			m_state->getSheet(m_state->m_actSheet, defFontType, *m_mainParser.getParseContext())->setRowHeight(row, height);
 		}
 		else
 		{
@@ -1262,7 +1279,7 @@ bool QuattroSpreadsheet::readRowRangeSize(std::shared_ptr<WPSStream> const &stre
 		if (minRow>=0 && minRow<=maxRow && m_state->m_actSheet>=0)
 		{
 			auto defFontType=m_mainParser.getDefaultFontType();
-			m_state->getSheet(m_state->m_actSheet, defFontType)->setRowHeights(minRow, maxRow, height);
+			m_state->getSheet(m_state->m_actSheet, defFontType, *m_mainParser.getParseContext())->setRowHeights(minRow, maxRow, height);
 		}
 		else
 		{
@@ -1591,7 +1608,7 @@ void QuattroSpreadsheet::sendSpreadsheet(int sId, std::vector<Vec2i> const &list
 		return;
 	}
 	auto defFontType=m_mainParser.getDefaultFontType();
-	auto sheet = m_state->getSheet(sId, defFontType);
+	auto sheet = m_state->getSheet(sId, defFontType, *m_mainParser.getParseContext());
 	for (auto c: listGraphicCells)
 		sheet->getCell(c, defFontType).m_hasGraphic=true;
 	m_listener->openSheet(sheet->getWidths(), m_state->getSheetName(sId));
@@ -37,6 +37,8 @@
 #include "WPSFont.h"
 #include "WPSHeader.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSStringStream.h"
 #include "WPSTable.h"
 
@@ -402,7 +404,7 @@ std::shared_ptr<WKSContentListener> WKS4Parser::createListener(librevenge::RVNGS
 		ps.setHeaderFooter(WPSPageSpan::FOOTER, WPSPageSpan::ALL, subdoc);
 	}
 	pageList.push_back(ps);
-	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface));
+	return std::shared_ptr<WKSContentListener>(new WKSContentListener(pageList, interface, getParseContext()));
 }
 
 ////////////////////////////////////////////////////////////
@@ -573,6 +575,7 @@ bool WKS4Parser::readZones()
 	{
 		if (m_state->m_isEncrypted && !m_state->m_isDecoded)
 			throw(libwps::PasswordException());
+		getParseContext()->checkProgress(input);
 	}
 
 	//
@@ -607,8 +610,36 @@ bool WKS4Parser::readZones()
 	return true;
 }
 
+bool WKS4Parser::isSkippedRecord(int type) const
+{
+	switch (type)
+	{
+	case 0x2d: // graph setting
+	case 0x2e: // named graph setting
+	case 0x41: // graph record name
+	case 0x5414: // chart axis
+	case 0x5415: // chart series
+	case 0x5416: // chart series styles
+	case 0x5431: // chart series color map
+	case 0x5435: // chart dimension
+	case 0x5440: // chart font
+	case 0x5444: // chart 3D
+	case 0x5480: // chart limits
+	case 0x5481:
+	case 0x5484: // chart font
+		return getParseContext()->skipCharts();
+	case 0x5456: // font
+	case 0x545a: // style
+		return getParseContext()->skipStyles();
+	default:
+		break;
+	}
+	return false;
+}
+
 bool WKS4Parser::readZone()
 {
+	getParseContext()->checkRecord();
 	libwps::DebugStream f;
 	RVNGInputStreamPtr input = getInput();
 	long pos = input->tell();
@@ -621,6 +652,12 @@ bool WKS4Parser::readZone()
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
+	if (isSkippedRecord(((type&0xff)<<8)|id))
+	{
+		input->seek(pos+4+sz, librevenge::RVNG_SEEK_SET);
+		return true;
+	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "WKS4", ((type&0xff)<<8)|id, 4+sz);
 
 	f << "Entries(Struct";
 	if (type == 0x54) f << "A";
@@ -1409,6 +1446,7 @@ bool WKS4Parser::readCString(librevenge::RVNGString &string, long maxSize)
 
 bool WKS4Parser::readFont()
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	libwps::DebugStream f;
 	RVNGInputStreamPtr input = getInput();
 	long pos = input->tell();
@@ -106,6 +106,8 @@ protected:
 
 	/** finds the different zones (spreadsheet, chart, print, ...) */
 	bool readZones();
+	//! returns true if a record must be skipped by length without being decoded: chart record when the charts are skipped, ...
+	bool isSkippedRecord(int type) const;
 	//! reads a zone
 	bool readZone();
 	//! reads a Quattro Pro zone
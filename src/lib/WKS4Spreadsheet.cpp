@@ -36,6 +36,8 @@
 #include "WKSContentListener.h"
 #include "WPSEntry.h"
 #include "WPSFont.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSTable.h"
 
 #include "WKS4.h"
@@ -273,14 +275,16 @@ public:
 	//! return a cell corresponding to a spreadsheet, create one if needed
 	Cell &getCell(Vec2i const &pos)
 	{
-		if (m_positionToCellMap.find(pos)==m_positionToCellMap.end())
+		// only one look up: the position is also used to insert the new cell
+		auto it=m_positionToCellMap.lower_bound(pos);
+		if (it==m_positionToCellMap.end() || pos<it->first)
 		{
 			Cell cell;
 			cell.setPosition(pos);
-			m_positionToCellMap[pos]=cell;
+			it=m_positionToCellMap.insert(it, std::map<Vec2i, Cell>::value_type(pos,cell));
 		}
 		m_lastCellPos=pos;
-		return m_positionToCellMap.find(pos)->second;
+		return it->second;
 	}
 	//! returns the last cell
 	Cell *getLastCell()
@@ -289,13 +293,19 @@ public:
 			return nullptr;
 		return &m_positionToCellMap.find(m_lastCellPos)->second;
 	}
-	//! set the columns size
-	void setColumnWidth(int col, int w=-1)
+	//! set the columns size, returns the number of created columns
+	int setColumnWidth(int col, int w=-1)
 	{
-		if (col < 0) return;
-		if (col >= int(m_widthCols.size())) m_widthCols.resize(size_t(col)+1, -1);
+		if (col < 0) return 0;
+		int numCreated=0;
+		if (col >= int(m_widthCols.size()))
+		{
+			numCreated=col+1-int(m_widthCols.size());
+			m_widthCols.resize(size_t(col)+1, -1);
+		}
 		m_widthCols[size_t(col)] = w;
 		if (col >= m_numCols) m_numCols=col+1;
+		return numCreated;
 	}
 
 	//! returns the row size in point
@@ -594,7 +604,7 @@ bool WKS4Spreadsheet::readSheetSize()
 	if (nRow==-1 && nCol==0) return true;
 	if (nRow < 0 || nCol <= 0) return false;
 
-	m_state->getActualSheet().setColumnWidth(nCol-1);
+	m_mainParser.getParseContext()->addCreatedCells(m_state->getActualSheet().setColumnWidth(nCol-1));
 	return true;
 
 }
@@ -637,7 +647,7 @@ bool WKS4Spreadsheet::readColumnSize()
 			f << "#col[inc],";
 		}
 		// checkme: unit in character(?) -> TWIP
-		m_state->getActualSheet().setColumnWidth(col, width*160);
+		m_mainParser.getParseContext()->addCreatedCells(m_state->getActualSheet().setColumnWidth(col, width*160));
 	}
 	ascii().addPos(pos);
 	ascii().addNote(f.str().c_str());
@@ -711,7 +721,7 @@ bool WKS4Spreadsheet::readMsWorksColumnSize()
 
 	bool ok = col >= 0 && col < m_state->getActualSheet().m_numCols+10;
 	if (ok)
-		m_state->getActualSheet().setColumnWidth(col, width & 0x7FFF);
+		m_mainParser.getParseContext()->addCreatedCells(m_state->getActualSheet().setColumnWidth(col, width & 0x7FFF));
 
 	f << "Entries(Colum2):Col" << col << ":";
 	if (!ok) f << "###";
@@ -797,6 +807,7 @@ bool WKS4Spreadsheet::readMsWorksPageBreak()
 
 bool WKS4Spreadsheet::readMsWorksStyle()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Styles);
 	libwps::DebugStream f;
 
 	long pos = m_input->tell();
@@ -1404,6 +1415,7 @@ bool WKS4Spreadsheet::readMsWorksDOSPageBreak()
 
 bool WKS4Spreadsheet::readCell()
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Cells);
 	libwps::DebugStream f;
 
 	long pos = m_input->tell();
@@ -1441,6 +1453,7 @@ bool WKS4Spreadsheet::readCell()
 		f << "###sheet[id]=" << sheetId << ",";
 	}
 
+	m_mainParser.getParseContext()->addCreatedCells(1);
 	auto &cell=m_state->getActualSheet().getCell(Vec2i(cellPos[0],cellPos[1]));
 	if (!dosFile)
 		cell.m_styleId = int(libwps::read16(m_input));
@@ -1511,7 +1524,9 @@ bool WKS4Spreadsheet::readCell()
 		}
 		cell.m_content.m_contentType=WKSContentListener::CellContent::C_TEXT;
 		long begText=m_input->tell(), endText=begText+dataSz;
+		// the string is only stored for the debug file, the alignment only needs its first character
 		std::string s("");
+		char firstC='\0';
 		for (int i = 0; i < dataSz; i++)
 		{
 			auto c = char(libwps::read8(m_input));
@@ -1523,15 +1538,16 @@ bool WKS4Spreadsheet::readCell()
 				f << "###";
 				break;
 			}
-			s += c;
+			if (i==0) firstC=c;
+			WPS_DEBUG_ANNOTATE(s += c);
 		}
-		f << s << ",";
-		if (dosFile && s.length())
+		WPS_DEBUG_ANNOTATE(f << s << ",");
+		if (dosFile && firstC)
 		{
-			if (s[0]=='\'') cell.m_hAlignement=WPSCellFormat::HALIGN_DEFAULT;
-			else if (s[0]=='\\') cell.m_hAlignement=WPSCellFormat::HALIGN_LEFT;
-			else if (s[0]=='^') cell.m_hAlignement=WPSCellFormat::HALIGN_CENTER;
-			else if (s[0]=='\"') cell.m_hAlignement=WPSCellFormat::HALIGN_RIGHT;
+			if (firstC=='\'') cell.m_hAlignement=WPSCellFormat::HALIGN_DEFAULT;
+			else if (firstC=='\\') cell.m_hAlignement=WPSCellFormat::HALIGN_LEFT;
+			else if (firstC=='^') cell.m_hAlignement=WPSCellFormat::HALIGN_CENTER;
+			else if (firstC=='\"') cell.m_hAlignement=WPSCellFormat::HALIGN_RIGHT;
 			else
 				--begText;
 			++begText;
@@ -1770,14 +1786,17 @@ bool WKS4Spreadsheet::readCellFormulaResult()
 	f << "C" << dim[0] << "x" << dim[1] << ",";
 	// skip format for windows file
 	if (!dosFile) m_input->seek(2, librevenge::RVNG_SEEK_CUR);
-	auto sSz=int(endPos-m_input->tell());
-	librevenge::RVNGString text;
-	if (!m_mainParser.readCString(text,sSz))
-		f << "##text,";
-	else if (!text.empty())
-		f << text.cstr() << ",";
-	if (m_input->tell()!=endPos)
-		ascii().addDelimiter(m_input->tell(),'|');
+	// the result is only decoded for the debug file
+	WPS_DEBUG_ANNOTATE(
+	    long const actPos=m_input->tell();
+	    librevenge::RVNGString text;
+	    if (!m_mainParser.readCString(text,endPos-actPos))
+	        f << "##text,";
+	    else if (!text.empty())
+	        f << text.cstr() << ",";
+	    if (m_input->tell()!=endPos)
+	        ascii().addDelimiter(m_input->tell(),'|');
+	    m_input->seek(actPos, librevenge::RVNG_SEEK_SET));
 	ascii().addPos(pos);
 	ascii().addNote(f.str().c_str());
 	m_input->seek(endPos, librevenge::RVNG_SEEK_SET);
@@ -1830,7 +1849,7 @@ bool WKS4Spreadsheet::readCell
 
 	if (pos[0] < 0 || pos[1] < 0)
 	{
-		std::stringstream f;
+		libwps::DebugStream f;
 		f << "###[" << pos[1] << "," << pos[0] << "]";
 		if (ok)
 		{
@@ -1904,6 +1923,7 @@ static Functions const s_listFunctions[] =
 bool WKS4Spreadsheet::readFormula(long endPos, Vec2i const &position,
                                   std::vector<WKSContentListener::FormulaInstruction> &formula, std::string &error)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_Formulas);
 	int const vers=version();
 	formula.resize(0);
 	error = "";
@@ -1912,7 +1932,7 @@ bool WKS4Spreadsheet::readFormula(long endPos, Vec2i const &position,
 	auto sz = int(libwps::readU16(m_input));
 	if (endPos-pos-2 != sz) return false;
 
-	std::stringstream f;
+	libwps::DebugStream f;
 	std::vector<std::vector<WKSContentListener::FormulaInstruction> > stack;
 	bool ok = true;
 	while (long(m_input->tell()) != endPos)
@@ -35,10 +35,13 @@
 #include "WKSContentListener.h"
 
 #include "WPSCell.h"
+#include "WPSEventRecorder.h"
 #include "WPSFont.h"
 #include "WPSGraphicShape.h"
 #include "WPSPageSpan.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSPosition.h"
 #include "WPSTable.h"
 #include "WKSChart.h"
@@ -58,6 +61,8 @@ struct WKSDocumentParsingState
 
 	bool m_isDocumentStarted, m_isHeaderFooterStarted;
 	std::vector<WPSSubDocumentPtr> m_subDocuments; /** list of document actually open */
+	//! the header/footers already sent and their recorded calls
+	std::vector<std::pair<WPSSubDocumentPtr, std::shared_ptr<WPSSpreadsheetEventRecorder> > > m_headerFooterCache;
 
 	/** a map cell's format to id */
 	std::map<WPSCellFormat,int,WPSCellFormat::CompareFormat> m_numberingIdMap;
@@ -73,6 +78,7 @@ WKSDocumentParsingState::WKSDocumentParsingState(std::vector<WPSPageSpan> const
 	, m_isDocumentStarted(false)
 	, m_isHeaderFooterStarted(false)
 	, m_subDocuments()
+	, m_headerFooterCache()
 	, m_numberingIdMap()
 {
 }
@@ -174,11 +180,13 @@ WKSContentParsingState::~WKSContentParsingState()
 {
 }
 
-WKSContentListener::WKSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGSpreadsheetInterface *documentInterface)
+WKSContentListener::WKSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGSpreadsheetInterface *documentInterface,
+                                       WPSParseContextPtr const &context)
 	: m_ds(new WKSDocumentParsingState(pageList))
 	, m_ps(new WKSContentParsingState)
 	, m_psStack()
 	, m_documentInterface(documentInterface)
+	, m_parseContext(context ? context : std::make_shared<WPSParseContext>())
 {
 }
 
@@ -402,6 +410,7 @@ void WKSContentListener::endDocument()
 ///////////////////
 void WKSContentListener::_openParagraph()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSheetOpened && !m_ps->m_isSheetCellOpened)
 		return;
 
@@ -424,6 +433,7 @@ void WKSContentListener::_openParagraph()
 
 void WKSContentListener::_closeParagraph()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isParagraphOpened)
 	{
 		if (m_ps->m_isSpanOpened)
@@ -455,6 +465,7 @@ void WKSContentListener::_appendParagraphProperties(librevenge::RVNGPropertyList
 ///////////////////
 void WKSContentListener::_openSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSpanOpened)
 		return;
 
@@ -474,6 +485,7 @@ void WKSContentListener::_openSpan()
 
 void WKSContentListener::_closeSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSpanOpened)
 		return;
 
@@ -510,6 +522,7 @@ void WKSContentListener::_flushDeferredTabs()
 
 void WKSContentListener::_flushText()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_textBuffer.len() == 0) return;
 
 	// when some many ' ' follows each other, call insertSpace
@@ -544,6 +557,8 @@ void WKSContentListener::_flushText()
 ///////////////////
 void WKSContentListener::insertComment(WPSSubDocumentPtr &subDocument)
 {
+	if (m_parseContext->skipComments())
+		return;
 	if (m_ps->m_isNote)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::insertComment try to insert a note recursively (ingnored)"));
@@ -620,6 +635,8 @@ void WKSContentListener::insertPicture
 (WPSPosition const &pos, const librevenge::RVNGBinaryData &binaryData, std::string type,
  WPSGraphicStyle const &style)
 {
+	if (m_parseContext->skipBinaryData()) return;
+	m_parseContext->addMemory(long(binaryData.size()));
 	if (!_openFrame(pos, style)) return;
 
 	librevenge::RVNGPropertyList propList;
@@ -633,6 +650,8 @@ void WKSContentListener::insertPicture
 void WKSContentListener::insertObject
 (WPSPosition const &pos, const WPSEmbeddedObject &obj, WPSGraphicStyle const &style)
 {
+	if (m_parseContext->skipBinaryData()) return;
+	m_parseContext->addMemory(obj.getDataSize());
 	if (!_openFrame(pos, style)) return;
 
 	librevenge::RVNGPropertyList propList;
@@ -930,6 +949,38 @@ void WKSContentListener::_handleFrameParameters
 // subdocument
 ///////////////////
 void WKSContentListener::handleSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType)
+{
+	if (subDocumentType!=libwps::DOC_HEADER_FOOTER || !subDocument || !m_documentInterface)
+	{
+		_sendSubDocument(subDocument, subDocumentType);
+		return;
+	}
+	// the header/footers are sent in each page span, so their calls are
+	// recorded the first time and replayed instead of parsing them again
+	for (auto const &cache : m_ds->m_headerFooterCache)
+	{
+		if (subDocument==cache.first)
+		{
+			cache.second->replay(*m_documentInterface);
+			return;
+		}
+	}
+	auto recorder=std::make_shared<WPSSpreadsheetEventRecorder>(m_documentInterface);
+	m_documentInterface=recorder.get();
+	try
+	{
+		_sendSubDocument(subDocument, subDocumentType);
+	}
+	catch (...)
+	{
+		m_documentInterface=recorder->getOutput();
+		throw;
+	}
+	m_documentInterface=recorder->getOutput();
+	m_ds->m_headerFooterCache.push_back(std::make_pair(subDocument, recorder));
+}
+
+void WKSContentListener::_sendSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType)
 {
 	_pushParsingState();
 	_startSubDocument();
@@ -999,6 +1050,7 @@ void WKSContentListener::_endSubDocument()
 ///////////////////
 void WKSContentListener::openSheet(std::vector<WPSColumnFormat> const &colList, librevenge::RVNGString const &name)
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSheetOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::openSheet: called with m_isSheetOpened=true\n"));
@@ -1033,6 +1085,7 @@ void WKSContentListener::openSheet(std::vector<WPSColumnFormat> const &colList,
 
 void WKSContentListener::closeSheet()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSheetOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::closeSheet: called with m_isSheetOpened=false\n"));
@@ -1048,6 +1101,7 @@ void WKSContentListener::closeSheet()
 
 void WKSContentListener::openSheetRow(WPSRowFormat const &format, int numRepeated)
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSheetRowOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::openSheetRow: called with m_isSheetRowOpened=true\n"));
@@ -1058,6 +1112,7 @@ void WKSContentListener::openSheetRow(WPSRowFormat const &format, int numRepeate
 		WPS_DEBUG_MSG(("WKSContentListener::openSheetRow: called with m_isSheetOpened=false\n"));
 		return;
 	}
+	m_parseContext->addCells(numRepeated);
 	librevenge::RVNGPropertyList propList;
 	format.addTo(propList);
 	if (numRepeated>1)
@@ -1068,6 +1123,7 @@ void WKSContentListener::openSheetRow(WPSRowFormat const &format, int numRepeate
 
 void WKSContentListener::closeSheetRow()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSheetRowOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::openSheetRow: called with m_isSheetRowOpened=false\n"));
@@ -1079,6 +1135,7 @@ void WKSContentListener::closeSheetRow()
 
 void WKSContentListener::openSheetCell(WPSCell const &cell, WKSContentListener::CellContent const &content, int numRepeated)
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSheetRowOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::openSheetCell: called with m_isSheetRowOpened=false\n"));
@@ -1089,6 +1146,7 @@ void WKSContentListener::openSheetCell(WPSCell const &cell, WKSContentListener::
 		WPS_DEBUG_MSG(("WKSContentListener::openSheetCell: called with m_isSheetCellOpened=true\n"));
 		closeSheetCell();
 	}
+	m_parseContext->addCells(numRepeated);
 
 	librevenge::RVNGPropertyList propList;
 	cell.addTo(propList);
@@ -1192,6 +1250,7 @@ void WKSContentListener::openSheetCell(WPSCell const &cell, WKSContentListener::
 
 void WKSContentListener::closeSheetCell()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSheetCellOpened)
 	{
 		WPS_DEBUG_MSG(("WKSContentListener::closeSheetCell: called with m_isSheetCellOpened=false\n"));
@@ -1209,6 +1268,7 @@ void WKSContentListener::closeSheetCell()
 ///////////////////
 void WKSContentListener::_openPageSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isPageSpanOpened)
 		return;
 
@@ -1261,6 +1321,7 @@ void WKSContentListener::_openPageSpan()
 
 void WKSContentListener::_closePageSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isPageSpanOpened)
 		return;
 
@@ -155,7 +155,8 @@ public:
 		std::vector<FormulaInstruction> m_formula;
 	};
 
-	WKSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGSpreadsheetInterface *documentInterface);
+	WKSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGSpreadsheetInterface *documentInterface,
+	                   WPSParseContextPtr const &context);
 	~WKSContentListener() final;
 
 	void setDocumentLanguage(int lcid) final;
@@ -248,6 +249,8 @@ protected:
 
 	void _startSubDocument();
 	void _endSubDocument();
+	//! sends a sub document to the interface, called by handleSubDocument
+	void _sendSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType);
 
 	void _openParagraph();
 	void _closeParagraph();
@@ -274,6 +277,8 @@ protected:
 	std::shared_ptr<WKSContentParsingState> m_ps; // parse state
 	std::vector<std::shared_ptr<WKSContentParsingState> > m_psStack;
 	librevenge::RVNGSpreadsheetInterface *m_documentInterface;
+	//! the parsing context
+	WPSParseContextPtr m_parseContext;
 
 private:
 	WKSContentListener(const WKSContentListener &) = delete;
@@ -24,17 +24,24 @@
 
 #include "WPSEntry.h"
 #include "WPSHeader.h"
+#include "WPSParseContext.h"
 
 #include "WKSParser.h"
 
 WKSParser::WKSParser(RVNGInputStreamPtr &input, WPSHeaderPtr &header)
 	: m_input(input)
 	, m_header(header)
+	, m_parseContext()
 	, m_version(0)
 	, m_asciiFile()
 {
 	if (header)
+	{
 		m_version = header->getMajorVersion();
+		m_parseContext = header->getParseContext();
+	}
+	if (!m_parseContext)
+		m_parseContext = std::make_shared<WPSParseContext>();
 }
 
 WKSParser::~WKSParser()
@@ -32,6 +32,8 @@
 #include "WPSHeader.h"
 #include "WPSOLEParser.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSTextSubDocument.h"
 
 #include "WPS4Graph.h"
@@ -301,7 +303,7 @@ std::shared_ptr<WPSContentListener> WPS4Parser::createListener(librevenge::RVNGT
 	for (int i = 1; i < numPages; i++) pageList.push_back(ps);
 	m_state->m_numPages=numPages;
 	return std::shared_ptr<WPSContentListener>
-	       (new WPSContentListener(pageList, interface));
+	       (new WPSContentListener(pageList, interface, getParseContext()));
 }
 
 void WPS4Parser::newPage(int number)
@@ -461,6 +463,7 @@ bool WPS4Parser::createStructures()
 
 bool WPS4Parser::createOLEStructures()
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_OLEStreams);
 	RVNGInputStreamPtr input=getFileInput();
 	if (!input) return false;
 
@@ -468,7 +471,7 @@ bool WPS4Parser::createOLEStructures()
 	WPSOLEParser oleParser("MN0", getDefaultFontType());
 	if (!oleParser.parse(input)) return false;
 
-	m_graphParser->storeObjects(oleParser.getObjectsMap());
+	m_graphParser->storeObjects(oleParser.releaseObjectsMap());
 #ifdef DEBUG
 	// there can remain some embedded Works subdocument ( WKS, ... )
 	// with name MN0 and some unknown picture ole
@@ -25,6 +25,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 #include <librevenge/librevenge.h>
 
@@ -35,7 +36,9 @@
 #include "WPSOLEObject.h"
 #include "WPSOLEParser.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 
 #include "WPS4.h"
@@ -94,13 +97,18 @@ void WPS4Graph::computePositions() const
 }
 
 // update the positions and send data to the listener
-void WPS4Graph::storeObjects(std::map<int,WPSEmbeddedObject> const &objectsMap)
+void WPS4Graph::storeObjects(std::map<int,WPSEmbeddedObject> &&objectsMap)
 {
-	for (auto it : objectsMap)
+	if (m_state->m_idToObjectMap.empty())
+	{
+		m_state->m_idToObjectMap=std::move(objectsMap);
+		return;
+	}
+	for (auto &it : objectsMap)
 	{
 		if (m_state->m_idToObjectMap.find(it.first)!=m_state->m_idToObjectMap.end())
 			continue;
-		m_state->m_idToObjectMap[it.first]=it.second;
+		m_state->m_idToObjectMap[it.first]=std::move(it.second);
 	}
 }
 
@@ -169,6 +177,7 @@ void WPS4Graph::sendObjects(int page)
 ////////////////////////////////////////////////////////////
 int WPS4Graph::readObject(RVNGInputStreamPtr input, WPSEntry const &entry)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	if (!entry.valid() || entry.length() <= 4)
 	{
 		WPS_DEBUG_MSG(("WPS4Graph::readObject: invalid object\n"));
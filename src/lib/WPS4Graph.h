@@ -85,7 +85,7 @@ protected:
 	int version() const;
 
 	//! store a list of object
-	void storeObjects(std::map<int,WPSEmbeddedObject> const &objectsMap);
+	void storeObjects(std::map<int,WPSEmbeddedObject> &&objectsMap);
 
 	/** tries to find a picture in the zone pointed by \a entry
 	 * \return the object id or -1 if find nothing
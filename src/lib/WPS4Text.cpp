@@ -51,6 +51,8 @@
 #include "WPSFont.h"
 #include "WPSPosition.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 
 #include "WPS4.h"
 
@@ -656,6 +658,7 @@ bool WPS4Text::readText(WPSEntry const &zone)
 		m_listener->insertCharacter(' ');
 		return false;
 	}
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "WPS4", zone.type(), zone.length());
 	if (mainZone)
 	{
 		int numCols = mainParser().numColumns();
@@ -674,26 +677,18 @@ bool WPS4Text::readText(WPSEntry const &zone)
 			}
 		}
 	}
-	auto FODs_iter = m_FODList.begin();
+	auto FODs_iter = m_FODList.cbegin();
 
 	// update the property to correspond to the text
 	int prevFId = -1, prevPId = -1;
-	if (simpleString) FODs_iter = m_FODList.end();
-	else if (FODs_iter == m_FODList.end() && mainZone)
+	if (simpleString) FODs_iter = m_FODList.cend();
+	else if (FODs_iter == m_FODList.cend() && mainZone)
 	{
 		WPS_DEBUG_MSG(("WPS4Text::readText: CAN NOT FIND any FODs for main zone, REVERT to basic string!!!!!!!!!\n"));
 		simpleString = true;
 	}
-
-	for (; FODs_iter!= m_FODList.end(); ++FODs_iter)
-	{
-		auto const &fod = *(FODs_iter);
-		if (fod.m_pos >= zone.begin()) break;
-
-		int id = (*FODs_iter).m_id;
-		if (fod.m_type == DataFOD::ATTR_TEXT) prevFId = id;
-		else if (fod.m_type == DataFOD::ATTR_PARAG) prevPId = id;
-	}
+	else
+		FODs_iter = findFOD(zone.begin(), prevFId, prevPId);
 
 	WPS4TextInternal::Font defaultFont(getDefaultFont());
 	WPS4TextInternal::Font actFont(defaultFont);
@@ -719,6 +714,7 @@ bool WPS4Text::readText(WPSEntry const &zone)
 		long lastPos;
 
 
+		getParseContext()->checkProgress(m_input);
 		libwps::DebugStream f;
 		f << "Text";
 
@@ -1160,14 +1156,14 @@ bool WPS4Text::readStructures()
 	std::vector<DataFOD> fdps;
 	for (auto const &fdp : m_state->m_FDPCs)
 		readFDP(fdp, fdps, static_cast<FDPParser>(&WPS4Text::readFont));
-	m_FODList = mergeSortedFODLists(fdps, m_FODList);
+	setFODList(mergeSortedFODLists(fdps, m_FODList));
 
 
 	/* read paragraphs FODs (FOrmatting Descriptors) */
 	fdps.resize(0);
 	for (auto const &fdp : m_state->m_FDPPs)
 		readFDP(fdp, fdps, static_cast<FDPParser>(&WPS4Text::readParagraph));
-	m_FODList = mergeSortedFODLists(fdps, m_FODList);
+	setFODList(mergeSortedFODLists(fdps, m_FODList));
 
 	/* read the object structures */
 	pos = nameMultiMap.find("EOBJ");
@@ -1329,6 +1325,7 @@ bool WPS4Text::findFDPStructuresByHand(int which)
 	long lastPos = m_textPositions.begin();
 	while (1)
 	{
+		getParseContext()->checkRecord();
 		m_input->seek(debPos+0x7f, librevenge::RVNG_SEEK_SET);
 		if (m_input->tell() != debPos+0x7f)
 		{
@@ -1602,8 +1599,13 @@ bool WPS4Text::readFont(long endPos, int &id, std::string &mess)
 	if (m_input->tell() != endPos)
 	{
 		f << "#unknEnd=(";
-		while (m_input->tell() < endPos) f << std::hex << libwps::readU8(m_input) <<",";
+		WPS_DEBUG_ANNOTATE(
+		    long const actPos=m_input->tell();
+		    while (m_input->tell() < endPos) f << std::hex << libwps::readU8(m_input) <<",";
+		    m_input->seek(actPos, librevenge::RVNG_SEEK_SET));
 		f << ")";
+		if (m_input->tell() < endPos)
+			m_input->seek(endPos, librevenge::RVNG_SEEK_SET);
 	}
 
 	font.m_attributes = attributes;
@@ -2111,8 +2113,10 @@ bool WPS4Text::readParagraph(long endPos, int &id, std::string &mess)
 		{
 			m_input->seek(pos, librevenge::RVNG_SEEK_SET);
 			f << "###v" << v<<"=" <<std::hex;
-			while (m_input->tell() < endPos)
-				f << int(libwps::readU8(m_input)) << ",";
+			WPS_DEBUG_ANNOTATE(
+			    while (m_input->tell() < endPos) f << int(libwps::readU8(m_input)) << ",";
+			    m_input->seek(pos, librevenge::RVNG_SEEK_SET));
+			m_input->seek(endPos, librevenge::RVNG_SEEK_SET);
 			break;
 		}
 
@@ -2602,7 +2606,7 @@ bool WPS4Text::readPLC
 		plc.m_name = zone.type();
 		plc.m_type = plcType.m_type;
 		m_state->m_plcList.push_back(plc);
-		m_FODList = mergeSortedFODLists(fods, m_FODList);
+		setFODList(mergeSortedFODLists(fods, m_FODList));
 		return true;
 	}
 
@@ -2667,7 +2671,7 @@ bool WPS4Text::readPLC
 		pos += dataSize;
 	}
 
-	if (ok) m_FODList = mergeSortedFODLists(fods, m_FODList);
+	if (ok) setFODList(mergeSortedFODLists(fods, m_FODList));
 	return true;
 }
 
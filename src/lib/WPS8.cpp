@@ -34,7 +34,9 @@
 #include "WPSHeader.h"
 #include "WPSOLEParser.h"
 #include "WPSPageSpan.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
+#include "WPSProfiler.h"
 #include "WPSTextSubDocument.h"
 
 #include "WPS8Graph.h"
@@ -427,7 +429,7 @@ std::shared_ptr<WPSContentListener> WPS8Parser::createListener(librevenge::RVNGT
 	for (int i = 1; i < numPages; i++) pageList.push_back(ps);
 	m_state->m_numPages=numPages;
 	return std::shared_ptr<WPSContentListener>
-	       (new WPSContentListener(pageList, interface));
+	       (new WPSContentListener(pageList, interface, getParseContext()));
 }
 
 void WPS8Parser::newPage(int number)
@@ -702,6 +704,7 @@ bool WPS8Parser::createStructures()
 
 bool WPS8Parser::createOLEStructures()
 {
+	WPSProfiler::Memory profileMemory(getParseContext()->getProfiler(), WPSProfiler::M_OLEStreams);
 	RVNGInputStreamPtr input=getFileInput();
 	if (!input) return false;
 
@@ -709,7 +712,7 @@ bool WPS8Parser::createOLEStructures()
 	WPSOLEParser oleParser("CONTENTS", libwps_tools_win::Font::WIN3_WEUROPE);
 	if (!oleParser.parse(input)) return false;
 
-	m_graphParser->storeObjects(oleParser.getObjectsMap());
+	m_graphParser->storeObjects(oleParser.releaseObjectsMap());
 #ifdef DEBUG
 	// there can remain some embedded Works subdocument ( WKS, ... )
 	// with name MN0 and some unknown picture ole
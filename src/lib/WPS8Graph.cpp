@@ -27,6 +27,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 #include <librevenge/librevenge.h>
 
@@ -36,7 +37,9 @@
 #include "WPSOLEObject.h"
 #include "WPSOLEParser.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
+#include "WPSProfiler.h"
 #include "WPSStream.h"
 
 #include "WPS8.h"
@@ -140,9 +143,9 @@ void WPS8Graph::computePositions() const
 	m_state->m_numPages = (m_state->m_pictMap.size() || m_state->m_oleMap.size()) ? 1 : 0;
 }
 
-void WPS8Graph::storeObjects(std::map<int,WPSEmbeddedObject> const &objectsMap)
+void WPS8Graph::storeObjects(std::map<int,WPSEmbeddedObject> &&objectsMap)
 {
-	m_state->m_oleMap=objectsMap;
+	m_state->m_oleMap=std::move(objectsMap);
 }
 
 ////////////////////////////////////////////////////////////
@@ -359,6 +362,7 @@ void WPS8Graph::sendBorder(int borderId)
 // Read a PICT/MEF4 entry :  read uncompressed picture of sx*sy of rgb
 bool WPS8Graph::readPICT(RVNGInputStreamPtr const &input, WPSEntry const &entry)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	long page_offset = entry.begin();
 	long length = entry.length();
 	long endPos = entry.end();
@@ -428,6 +432,7 @@ bool WPS8Graph::readPICT(RVNGInputStreamPtr const &input, WPSEntry const &entry)
 // Warning: only seems very simple IBGF, complex may differ
 bool WPS8Graph::readIBGF(RVNGInputStreamPtr const &input, WPSEntry const &entry)
 {
+	WPSProfiler::Memory profileMemory(m_mainParser.getParseContext()->getProfiler(), WPSProfiler::M_EmbeddedObjects);
 	libwps::DebugStream f;
 	if (!entry.hasType(entry.name()))
 	{
@@ -103,7 +103,7 @@ protected:
 	void sendBorder(int borderId);
 
 	//! adds a list of object
-	void storeObjects(std::map<int,WPSEmbeddedObject> const &objectsMap);
+	void storeObjects(std::map<int,WPSEmbeddedObject> &&objectsMap);
 
 	//! finds all entries which correspond to some pictures, parses them and stores data
 	bool readStructures(RVNGInputStreamPtr const &input);
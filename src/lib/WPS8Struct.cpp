@@ -46,9 +46,14 @@ std::string FileData::createErrorString(RVNGInputStreamPtr input, long endPos)
 {
 	libwps::DebugStream f;
 	f << ",###unread=(" << std::hex;
-	while (input->tell() < endPos-1) f << libwps::readU16(input) << ", ";
-	if (input->tell() < endPos)  f << libwps::readU8(input) << ", ";
+	WPS_DEBUG_ANNOTATE(
+	    long const actPos=input->tell();
+	    while (input->tell() < endPos-1) f << libwps::readU16(input) << ", ";
+	    if (input->tell() < endPos)  f << libwps::readU8(input) << ", ";
+	    input->seek(actPos, librevenge::RVNG_SEEK_SET));
 	f << ")";
+	if (input->tell() < endPos)
+		input->seek(endPos, librevenge::RVNG_SEEK_SET);
 
 	return f.str();
 }
@@ -31,6 +31,8 @@
 #include "WPSEntry.h"
 #include "WPSList.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSTextSubDocument.h"
 
 #include "WPS8.h"
@@ -677,6 +679,7 @@ void WPS8Text::readText(WPSEntry const &entry)
 	}
 	RVNGInputStreamPtr input = getInput();
 	m_state->setParsed(entry,true);
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "WPS8", entry.type(), entry.length());
 	bool mainZone = entry.id()==1;
 	if (mainZone && mainParser().numColumns() > 1)
 	{
@@ -688,20 +691,13 @@ void WPS8Text::readText(WPSEntry const &entry)
 		m_listener->openSection(colSize, librevenge::RVNG_POINT);
 	}
 	int lastCId=-1, lastPId=-1; /* -2: nothing, -1: send default, >= 0: readId */
-	auto plcIt =  m_FODList.begin();
-	while (plcIt != m_FODList.end() && plcIt->m_pos < entry.begin())
-	{
-		auto const &plc = *(plcIt++);
-		if (plc.m_type==DataFOD::ATTR_TEXT)
-			lastCId = plc.m_id;
-		else if (plc.m_type==DataFOD::ATTR_PARAG)
-			lastPId = plc.m_id;
-	}
+	auto plcIt = findFOD(entry.begin(), lastCId, lastPId);
 	int actualPage = 1;
 	WPS8TextStyle::FontData special;
 	input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
 	while (!input->isEnd())
 	{
+		getParseContext()->checkProgress(input);
 		long pos = input->tell();
 		libwps::DebugStream f;
 		f << "TEXT:";
@@ -953,7 +949,7 @@ bool WPS8Text::readStructures()
 {
 	auto &nameTable = getNameEntryMap();
 	/* What is the total length of the text? */
-	auto pos = nameTable.lower_bound("TEXT");
+	auto pos = nameTable.find("TEXT");
 	if (nameTable.end() == pos)
 	{
 		WPS_DEBUG_MSG(("Works: error: no TEXT in header index table\n"));
@@ -1585,7 +1581,7 @@ bool WPS8Text::bmktEndDataParser(long endPage, std::vector<long> const &textPtrs
 	}
 
 	if (fods.size())
-		m_FODList = mergeSortedFODLists(m_FODList, fods);
+		setFODList(mergeSortedFODLists(m_FODList, fods));
 
 	return true;
 
@@ -1911,7 +1907,7 @@ bool WPS8Text::tokenEndDataParser(long endPage, std::vector<long> const &textPtr
 	}
 
 	if (fods.size())
-		m_FODList = mergeSortedFODLists(m_FODList, fods);
+		setFODList(mergeSortedFODLists(m_FODList, fods));
 
 	return true;
 }
@@ -2203,7 +2199,7 @@ bool WPS8Text::readPLC
 		else plcType.m_contentType = WPS8PLCInternal::PLC::T_UNKNOWN;
 	}
 	if (fods.size())
-		m_FODList = mergeSortedFODLists(m_FODList, fods);
+		setFODList(mergeSortedFODLists(m_FODList, fods));
 
 	ascii().addPos(page_offset);
 	ascii().addNote(f.str().c_str());
@@ -200,7 +200,7 @@ bool WPS8TextStyle::readStructures()
 		                             : WPS8Text::FDPParser(&WPS8Text::readFont);
 		for (auto const &z : zones)
 			m_mainParser.readFDP(z, fdps, parser);
-		m_mainParser.m_FODList = m_mainParser.mergeSortedFODLists(m_mainParser.m_FODList, fdps);
+		m_mainParser.setFODList(m_mainParser.mergeSortedFODLists(m_mainParser.m_FODList, fdps));
 	}
 	// read SGP zone
 	pos = nameTable.lower_bound("SGP ");
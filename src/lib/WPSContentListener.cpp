@@ -34,10 +34,13 @@
 #include "WPSContentListener.h"
 
 #include "WPSCell.h"
+#include "WPSEventRecorder.h"
 #include "WPSFont.h"
 #include "WPSList.h"
 #include "WPSPageSpan.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 #include "WPSPosition.h"
 #include "WPSTextSubDocument.h"
 
@@ -58,6 +61,8 @@ struct WPSDocumentParsingState
 
 	bool m_isDocumentStarted, m_isHeaderFooterStarted;
 	std::vector<WPSSubDocumentPtr> m_subDocuments; /** list of document actually open */
+	//! the header/footers already sent and their recorded calls
+	std::vector<std::pair<WPSSubDocumentPtr, std::shared_ptr<WPSTextEventRecorder> > > m_headerFooterCache;
 
 private:
 	WPSDocumentParsingState(const WPSDocumentParsingState &) = delete;
@@ -73,6 +78,7 @@ WPSDocumentParsingState::WPSDocumentParsingState(std::vector<WPSPageSpan> const
 	, m_isDocumentStarted(false)
 	, m_isHeaderFooterStarted(false)
 	, m_subDocuments()
+	, m_headerFooterCache()
 {
 }
 
@@ -208,11 +214,13 @@ WPSContentParsingState::~WPSContentParsingState()
 {
 }
 
-WPSContentListener::WPSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface)
+WPSContentListener::WPSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface,
+                                       WPSParseContextPtr const &context)
 	: m_ds(new WPSDocumentParsingState(pageList))
 	, m_ps(new WPSContentParsingState)
 	, m_psStack()
 	, m_documentInterface(documentInterface)
+	, m_parseContext(context ? context : std::make_shared<WPSParseContext>())
 {
 	_updatePageSpanDependent(true);
 }
@@ -590,6 +598,7 @@ void WPSContentListener::endDocument()
 ///////////////////
 void WPSContentListener::_openPageSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isPageSpanOpened)
 		return;
 
@@ -646,6 +655,7 @@ void WPSContentListener::_openPageSpan()
 
 void WPSContentListener::_closePageSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isPageSpanOpened)
 		return;
 
@@ -665,6 +675,7 @@ void WPSContentListener::_updatePageSpanDependent(bool /*set*/)
 ///////////////////
 void WPSContentListener::_openSection()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSectionOpened)
 	{
 		WPS_DEBUG_MSG(("WPSContentListener::_openSection: a section is already opened\n"));
@@ -702,6 +713,7 @@ void WPSContentListener::_openSection()
 
 void WPSContentListener::_closeSection()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSectionOpened ||m_ps->m_isTableOpened)
 		return;
 
@@ -721,6 +733,8 @@ void WPSContentListener::_closeSection()
 ///////////////////
 void WPSContentListener::_openParagraph()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
+	m_parseContext->checkRecord();
 	if (m_ps->m_isTableOpened && !m_ps->m_isTableCellOpened)
 		return;
 
@@ -750,6 +764,7 @@ void WPSContentListener::_openParagraph()
 
 void WPSContentListener::_closeParagraph()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isListElementOpened)
 	{
 		_closeListElement();
@@ -821,6 +836,7 @@ void WPSContentListener::_appendParagraphProperties
 ///////////////////
 void WPSContentListener::_openListElement()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isTableOpened && !m_ps->m_isTableCellOpened)
 		return;
 
@@ -846,6 +862,7 @@ void WPSContentListener::_openListElement()
 
 void WPSContentListener::_closeListElement()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isListElementOpened)
 	{
 		if (m_ps->m_isSpanOpened)
@@ -939,6 +956,7 @@ void WPSContentListener::_changeList()
 ///////////////////
 void WPSContentListener::_openSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_isSpanOpened)
 		return;
 
@@ -964,6 +982,7 @@ void WPSContentListener::_openSpan()
 
 void WPSContentListener::_closeSpan()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (!m_ps->m_isSpanOpened)
 		return;
 
@@ -1000,6 +1019,7 @@ void WPSContentListener::_flushDeferredTabs()
 
 void WPSContentListener::_flushText()
 {
+	WPSProfiler::Emission profileEmission(m_parseContext->getProfiler());
 	if (m_ps->m_textBuffer.len() == 0) return;
 
 	// when some many ' ' follows each other, call insertSpace
@@ -1144,6 +1164,8 @@ void WPSContentListener::insertPicture
 (WPSPosition const &pos, const librevenge::RVNGBinaryData &binaryData, std::string type,
  librevenge::RVNGPropertyList frameExtras)
 {
+	if (m_parseContext->skipBinaryData()) return;
+	m_parseContext->addMemory(long(binaryData.size()));
 	if (!_openFrame(pos, frameExtras)) return;
 
 	librevenge::RVNGPropertyList propList;
@@ -1157,6 +1179,8 @@ void WPSContentListener::insertPicture
 void WPSContentListener::insertObject(WPSPosition const &pos, const WPSEmbeddedObject &obj,
                                       librevenge::RVNGPropertyList frameExtras)
 {
+	if (m_parseContext->skipBinaryData()) return;
+	m_parseContext->addMemory(obj.getDataSize());
 	if (!_openFrame(pos, frameExtras)) return;
 
 	librevenge::RVNGPropertyList propList;
@@ -1536,6 +1560,49 @@ void WPSContentListener::_handleFrameParameters
 // subdocument
 ///////////////////
 void WPSContentListener::handleSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType)
+{
+	if (subDocumentType!=libwps::DOC_HEADER_FOOTER || !subDocument || !m_documentInterface)
+	{
+		_sendSubDocument(subDocument, subDocumentType);
+		return;
+	}
+	// the header/footers are sent in each page span, so their calls are
+	// recorded the first time and replayed instead of parsing them again
+	for (auto const &cache : m_ds->m_headerFooterCache)
+	{
+		if (subDocument==cache.first)
+		{
+			cache.second->replay(*m_documentInterface);
+			return;
+		}
+	}
+	int const newListId=m_ds->m_newListId;
+	int const footNoteNumber=m_ds->m_footNoteNumber, endNoteNumber=m_ds->m_endNoteNumber;
+	auto recorder=std::make_shared<WPSTextEventRecorder>(m_documentInterface);
+	m_documentInterface=recorder.get();
+	try
+	{
+		_sendSubDocument(subDocument, subDocumentType);
+	}
+	catch (...)
+	{
+		m_documentInterface=recorder->getOutput();
+		throw;
+	}
+	m_documentInterface=recorder->getOutput();
+	/* a replay does not allocate new list ids nor note numbers, so a
+	   header/footer which creates a list or a note is parsed again in
+	   each page span.
+
+	   \note the other changes of the parsers' states done while sending
+	   the header/footer are not replayed, so a header/footer must send
+	   the same calls each time it is sent */
+	if (m_ds->m_newListId==newListId && m_ds->m_footNoteNumber==footNoteNumber &&
+	        m_ds->m_endNoteNumber==endNoteNumber)
+		m_ds->m_headerFooterCache.push_back(std::make_pair(subDocument, recorder));
+}
+
+void WPSContentListener::_sendSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType)
 {
 	_pushParsingState();
 	_startSubDocument();
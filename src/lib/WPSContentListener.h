@@ -44,8 +44,14 @@ struct WPSDocumentParsingState;
 class WPSContentListener final : public WPSListener
 {
 public:
-	WPSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface);
+	WPSContentListener(std::vector<WPSPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface,
+	                   WPSParseContextPtr const &context);
 	~WPSContentListener() final;
+	//! returns the parsing context: options, ...
+	WPSParseContextPtr const &getParseContext() const
+	{
+		return m_parseContext;
+	}
 
 	void setDocumentLanguage(int lcid) final;
 	void setMetaData(const librevenge::RVNGPropertyList &list);
@@ -158,6 +164,8 @@ protected:
 
 	void _startSubDocument();
 	void _endSubDocument();
+	//! sends a sub document to the interface, called by handleSubDocument
+	void _sendSubDocument(WPSSubDocumentPtr &subDocument, libwps::SubDocumentType subDocumentType);
 
 	void _handleFrameParameters(librevenge::RVNGPropertyList &propList, WPSPosition const &pos);
 	bool _openFrame(WPSPosition const &pos, librevenge::RVNGPropertyList extras=librevenge::RVNGPropertyList());
@@ -192,6 +200,8 @@ protected:
 	std::shared_ptr<WPSContentParsingState> m_ps; // parse state
 	std::vector<std::shared_ptr<WPSContentParsingState> > m_psStack;
 	librevenge::RVNGTextInterface *m_documentInterface;
+	//! the parsing context
+	WPSParseContextPtr m_parseContext;
 
 private:
 	WPSContentListener(const WPSContentListener &);
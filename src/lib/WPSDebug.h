@@ -54,6 +54,15 @@ std::string flattenFileName(std::string const &name);
 //! a basic stream (if debug_with_files is not defined, does nothing)
 typedef std::stringstream DebugStream;
 
+/** \def WPS_DEBUG_ANNOTATE(X)
+	executes X only if the debug files are created (ie. if debug_with_files
+	is defined). It must be used when computing an annotation is costly:
+	X must only modify some DebugStream or DebugFile and must not change
+	the parser's state, as in release builds, X is not evaluated: if X
+	reads the input, it must leave the input where it found it.
+ */
+#define WPS_DEBUG_ANNOTATE(X) do { X; } while (false)
+
 //! an interface used to insert comment in a binary file,
 //! written in ascii form (if debug_with_files is not defined, does nothing)
 class DebugFile
@@ -188,6 +197,12 @@ inline std::string flattenFileName(std::string const &name)
 }
 }
 
+/** a basic stream which does nothing.
+
+	\note the arguments of operator<< are still evaluated, as they can
+	read the input; use WPS_DEBUG_ANNOTATE to avoid computing a costly
+	annotation.
+*/
 class DebugStream
 {
 public:
@@ -199,11 +214,13 @@ public:
 
 	static std::string str()
 	{
-		return std::string("");
+		return std::string();
 	}
 	static void str(std::string const &) { }
 };
 
+#define WPS_DEBUG_ANNOTATE(X) do { } while (false)
+
 class DebugFile
 {
 public:
@@ -39,6 +39,7 @@
 #include "WPS8.h"
 #include "MSWrite.h"
 #include "WPSHeader.h"
+#include "WPSParseContext.h"
 #include "WPSParser.h"
 #include "XYWrite.h"
 
@@ -220,7 +221,13 @@ WPSLIB WPSConfidence WPSDocument::isFileFormatSupported(librevenge::RVNGInputStr
 }
 
 WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge::RVNGTextInterface *documentInterface,
-                                    char const * /*password*/, char const *encoding)
+                                    char const *password, char const *encoding)
+{
+	return parse(ip, documentInterface, WPSParseOptions(), password, encoding);
+}
+
+WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge::RVNGTextInterface *documentInterface,
+                                    WPSParseOptions const &options, char const * /*password*/, char const *encoding)
 {
 	if (!ip || !documentInterface)
 		return WPS_UNKNOWN_ERROR;
@@ -230,12 +237,14 @@ WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge:
 	WPSHeaderPtr header;
 	std::shared_ptr<WPSParser> parser;
 	std::shared_ptr<librevenge::RVNGInputStream > input(ip, WPS_shared_ptr_noop_deleter<librevenge::RVNGInputStream>());
+	auto context=std::make_shared<WPSParseContext>(options);
 	try
 	{
 		header.reset(WPSHeader::constructHeader(input));
 
 		if (!header || header->getKind() != WPS_TEXT)
 			return WPS_UNKNOWN_ERROR;
+		header->setParseContext(context);
 
 		if (header->getCreator() == WPS_MSWRITE)
 		{
@@ -308,18 +317,39 @@ WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge:
 		WPS_DEBUG_MSG(("Password exception trapped\n"));
 		error = WPS_ENCRYPTION_ERROR;
 	}
+	catch (libwps::LimitException)
+	{
+		WPS_DEBUG_MSG(("Limit exception trapped\n"));
+		error = WPS_LIMIT_EXCEEDED_ERROR;
+	}
+	catch (libwps::CancelException)
+	{
+		WPS_DEBUG_MSG(("Cancel exception trapped\n"));
+		error = WPS_CANCELLED_ERROR;
+	}
 	catch (...)
 	{
 		//fixme: too generic
 		WPS_DEBUG_MSG(("Unknown exception trapped\n"));
 		error = WPS_UNKNOWN_ERROR;
 	}
+	// the parsers can catch and convert the exceptions, so check also the context
+	if (context->isCancelled())
+		error = WPS_CANCELLED_ERROR;
+	else if (context->isLimitExceeded())
+		error = WPS_LIMIT_EXCEEDED_ERROR;
 
 	return error;
 }
 
 WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge::RVNGSpreadsheetInterface *documentInterface,
                                     char const *password, char const *encoding)
+{
+	return parse(ip, documentInterface, WPSParseOptions(), password, encoding);
+}
+
+WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge::RVNGSpreadsheetInterface *documentInterface,
+                                    WPSParseOptions const &options, char const *password, char const *encoding)
 {
 	if (!ip || !documentInterface)
 		return WPS_UNKNOWN_ERROR;
@@ -329,12 +359,14 @@ WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge:
 	WPSHeaderPtr header;
 	std::shared_ptr<WKSParser> parser;
 	std::shared_ptr<librevenge::RVNGInputStream > input(ip, WPS_shared_ptr_noop_deleter<librevenge::RVNGInputStream>());
+	auto context=std::make_shared<WPSParseContext>(options);
 	try
 	{
 		header.reset(WPSHeader::constructHeader(input));
 
 		if (!header || (header->getKind() != WPS_SPREADSHEET && header->getKind() != WPS_DATABASE))
 			return WPS_UNKNOWN_ERROR;
+		header->setParseContext(context);
 
 		if (header->getKind() == WPS_SPREADSHEET && header->getCreator() == WPS_LOTUS &&
 		        header->getMajorVersion()>=100)
@@ -391,12 +423,27 @@ WPSLIB WPSResult WPSDocument::parse(librevenge::RVNGInputStream *ip, librevenge:
 		WPS_DEBUG_MSG(("Password exception trapped\n"));
 		error = WPS_ENCRYPTION_ERROR;
 	}
+	catch (libwps::LimitException)
+	{
+		WPS_DEBUG_MSG(("Limit exception trapped\n"));
+		error = WPS_LIMIT_EXCEEDED_ERROR;
+	}
+	catch (libwps::CancelException)
+	{
+		WPS_DEBUG_MSG(("Cancel exception trapped\n"));
+		error = WPS_CANCELLED_ERROR;
+	}
 	catch (...)
 	{
 		//fixme: too generic
 		WPS_DEBUG_MSG(("Unknown exception trapped\n"));
 		error = WPS_UNKNOWN_ERROR;
 	}
+	// the parsers can catch and convert the exceptions, so check also the context
+	if (context->isCancelled())
+		error = WPS_CANCELLED_ERROR;
+	else if (context->isLimitExceeded())
+		error = WPS_LIMIT_EXCEEDED_ERROR;
 
 	return error;
 }
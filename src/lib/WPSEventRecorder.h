@@ -0,0 +1,150 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef WPS_EVENT_RECORDER_H
+#define WPS_EVENT_RECORDER_H
+
+#include <functional>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+#include "WPSInterfaceMethods.h"
+
+/** the base of the interfaces which send the calls to another interface
+	and record them, so that they can be sent again without parsing.
+ */
+template <class Interface>
+class WPSEventRecorderBase : public Interface
+{
+public:
+	//! the recorded interface
+	typedef Interface RecordedInterface;
+	//! constructor
+	explicit WPSEventRecorderBase(Interface *output)
+		: Interface()
+		, m_output(output)
+		, m_events()
+	{
+	}
+	//! returns the interface which receives the calls
+	Interface *getOutput() const
+	{
+		return m_output;
+	}
+	//! sends the recorded calls to listener
+	void replay(Interface &listener) const
+	{
+		for (auto const &event : m_events)
+			event(listener);
+	}
+
+protected:
+	//! sends a call without argument to the output and records it
+	void record(void (Interface::*method)())
+	{
+		(m_output->*method)();
+		m_events.push_back([method](Interface &listener)
+		{
+			(listener.*method)();
+		});
+	}
+	//! sends a call with a property list to the output and records it
+	void record(void (Interface::*method)(const librevenge::RVNGPropertyList &), const librevenge::RVNGPropertyList &propList)
+	{
+		(m_output->*method)(propList);
+		m_events.push_back([method, propList](Interface &listener)
+		{
+			(listener.*method)(propList);
+		});
+	}
+	//! sends a call with a string to the output and records it
+	void record(void (Interface::*method)(const librevenge::RVNGString &), const librevenge::RVNGString &text)
+	{
+		(m_output->*method)(text);
+		m_events.push_back([method, text](Interface &listener)
+		{
+			(listener.*method)(text);
+		});
+	}
+
+private:
+	WPSEventRecorderBase(WPSEventRecorderBase const &) = delete;
+	WPSEventRecorderBase &operator=(WPSEventRecorderBase const &) = delete;
+	//! the interface which receives the calls
+	Interface *m_output;
+	//! the recorded calls
+	std::vector<std::function<void(Interface &)> > m_events;
+};
+
+//! defines a recorder method with a property list
+#define WPS_RECORD_PROPLIST_METHOD(name) \
+	void name(const librevenge::RVNGPropertyList &propList) final \
+	{ \
+		record(&RecordedInterface::name, propList); \
+	}
+//! defines a recorder method without argument
+#define WPS_RECORD_NOARG_METHOD(name) \
+	void name() final \
+	{ \
+		record(&RecordedInterface::name); \
+	}
+//! defines a recorder method with a string
+#define WPS_RECORD_STRING_METHOD(name) \
+	void name(const librevenge::RVNGString &text) final \
+	{ \
+		record(&RecordedInterface::name, text); \
+	}
+
+/** a text interface which sends the calls to another interface and
+	records them, so that they can be sent again without parsing.
+
+	This is used to send the same header/footer in each page span.
+ */
+class WPSTextEventRecorder final : public WPSEventRecorderBase<librevenge::RVNGTextInterface>
+{
+public:
+	//! constructor
+	explicit WPSTextEventRecorder(librevenge::RVNGTextInterface *output);
+	//! destructor
+	~WPSTextEventRecorder() final;
+
+	WPS_TEXT_INTERFACE_METHODS(WPS_RECORD_PROPLIST_METHOD, WPS_RECORD_NOARG_METHOD, WPS_RECORD_STRING_METHOD,
+	                           WPS_RECORD_PROPLIST_METHOD, WPS_RECORD_NOARG_METHOD)
+};
+
+/** a spreadsheet interface which sends the calls to another interface
+	and records them, so that they can be sent again without parsing.
+ */
+class WPSSpreadsheetEventRecorder final : public WPSEventRecorderBase<librevenge::RVNGSpreadsheetInterface>
+{
+public:
+	//! constructor
+	explicit WPSSpreadsheetEventRecorder(librevenge::RVNGSpreadsheetInterface *output);
+	//! destructor
+	~WPSSpreadsheetEventRecorder() final;
+
+	WPS_TEXT_INTERFACE_METHODS(WPS_RECORD_PROPLIST_METHOD, WPS_RECORD_NOARG_METHOD, WPS_RECORD_STRING_METHOD,
+	                           WPS_IGNORE_METHOD, WPS_IGNORE_METHOD)
+	WPS_SPREADSHEET_INTERFACE_METHODS(WPS_RECORD_PROPLIST_METHOD, WPS_RECORD_NOARG_METHOD)
+};
+
+#undef WPS_RECORD_PROPLIST_METHOD
+#undef WPS_RECORD_NOARG_METHOD
+#undef WPS_RECORD_STRING_METHOD
+
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -24,6 +24,8 @@
 
 #include "libwps_internal.h"
 
+#include "WPSParseContext.h"
+
 #include "WPSHeader.h"
 
 using namespace libwps;
@@ -36,6 +38,7 @@ WPSHeader::WPSHeader(RVNGInputStreamPtr &input, RVNGInputStreamPtr &fileInput, i
 	, m_creator(creator)
 	, m_isEncrypted(false)
 	, m_needEncodingFlag(false)
+	, m_parseContext(new WPSParseContext)
 {
 }
 
@@ -43,6 +46,16 @@ WPSHeader::~WPSHeader()
 {
 }
 
+void WPSHeader::setParseContext(WPSParseContextPtr const &context)
+{
+	if (!context)
+	{
+		WPS_DEBUG_MSG(("WPSHeader::setParseContext: called without context\n"));
+		return;
+	}
+	m_parseContext=context;
+}
+
 
 /**
  * So far, we have identified three categories of Works documents.
@@ -96,6 +96,15 @@ public:
 		m_majorVersion=version;
 	}
 
+	//! returns the parsing context
+	WPSParseContextPtr const &getParseContext() const
+	{
+		return m_parseContext;
+	}
+
+	//! sets the parsing context
+	void setParseContext(WPSParseContextPtr const &context);
+
 private:
 	WPSHeader(const WPSHeader &) = delete;
 	WPSHeader &operator=(const WPSHeader &) = delete;
@@ -108,6 +117,8 @@ private:
 	bool m_isEncrypted;
 	//! a flag to know if we need to have the character set encoding
 	bool m_needEncodingFlag;
+	//! the parsing context: options, ...
+	WPSParseContextPtr m_parseContext;
 };
 
 #endif /* WPSHEADER_H */
@@ -0,0 +1,147 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef WPS_INTERFACE_METHODS_H
+#define WPS_INTERFACE_METHODS_H
+
+/* the lists of the methods of the librevenge interfaces, used to
+   generate the classes which forward or record each call:
+   WPSTextEventRecorder, WPSSpreadsheetEventRecorder and the converters'
+   tee and event log.
+
+   Each list calls one of its macro arguments with the method name,
+   depending on the method arguments:
+   - PROPLIST for a method with a property list,
+   - NOARG for a method without argument,
+   - STRING for a method with a string (insertText).
+
+   \note the order of the methods is used by the event log format, so
+   new methods must be added at the end of the lists.
+ */
+
+//! a list macro argument which ignores a method
+#define WPS_IGNORE_METHOD(name)
+
+/** the methods of librevenge::RVNGTextInterface.
+
+	The methods which do not exist in librevenge::RVNGSpreadsheetInterface
+	are sent to TEXT_PROPLIST and TEXT_NOARG, so WPS_TEXT_INTERFACE_METHODS
+	followed by WPS_SPREADSHEET_INTERFACE_METHODS with
+	TEXT_PROPLIST=TEXT_NOARG=WPS_IGNORE_METHOD lists the methods of
+	librevenge::RVNGSpreadsheetInterface.
+ */
+#define WPS_TEXT_INTERFACE_METHODS(PROPLIST, NOARG, STRING, TEXT_PROPLIST, TEXT_NOARG) \
+	PROPLIST(setDocumentMetaData) \
+	PROPLIST(startDocument) \
+	NOARG(endDocument) \
+	PROPLIST(definePageStyle) \
+	PROPLIST(defineEmbeddedFont) \
+	PROPLIST(openPageSpan) \
+	NOARG(closePageSpan) \
+	PROPLIST(openHeader) \
+	NOARG(closeHeader) \
+	PROPLIST(openFooter) \
+	NOARG(closeFooter) \
+	PROPLIST(defineParagraphStyle) \
+	PROPLIST(openParagraph) \
+	NOARG(closeParagraph) \
+	PROPLIST(defineCharacterStyle) \
+	PROPLIST(openSpan) \
+	NOARG(closeSpan) \
+	PROPLIST(openLink) \
+	NOARG(closeLink) \
+	TEXT_PROPLIST(defineSectionStyle) \
+	TEXT_PROPLIST(openSection) \
+	TEXT_NOARG(closeSection) \
+	NOARG(insertTab) \
+	NOARG(insertSpace) \
+	STRING(insertText) \
+	NOARG(insertLineBreak) \
+	PROPLIST(insertField) \
+	PROPLIST(openOrderedListLevel) \
+	PROPLIST(openUnorderedListLevel) \
+	NOARG(closeOrderedListLevel) \
+	NOARG(closeUnorderedListLevel) \
+	PROPLIST(openListElement) \
+	NOARG(closeListElement) \
+	PROPLIST(openFootnote) \
+	NOARG(closeFootnote) \
+	TEXT_PROPLIST(openEndnote) \
+	TEXT_NOARG(closeEndnote) \
+	PROPLIST(openComment) \
+	NOARG(closeComment) \
+	PROPLIST(openTextBox) \
+	NOARG(closeTextBox) \
+	PROPLIST(openTable) \
+	PROPLIST(openTableRow) \
+	NOARG(closeTableRow) \
+	PROPLIST(openTableCell) \
+	NOARG(closeTableCell) \
+	PROPLIST(insertCoveredTableCell) \
+	NOARG(closeTable) \
+	PROPLIST(openFrame) \
+	NOARG(closeFrame) \
+	PROPLIST(insertBinaryObject) \
+	PROPLIST(insertEquation) \
+	PROPLIST(openGroup) \
+	NOARG(closeGroup) \
+	PROPLIST(defineGraphicStyle) \
+	PROPLIST(drawRectangle) \
+	PROPLIST(drawEllipse) \
+	PROPLIST(drawPolygon) \
+	PROPLIST(drawPolyline) \
+	PROPLIST(drawPath) \
+	PROPLIST(drawConnector)
+
+//! the methods which only exist in librevenge::RVNGSpreadsheetInterface
+#define WPS_SPREADSHEET_INTERFACE_METHODS(PROPLIST, NOARG) \
+	PROPLIST(defineSheetNumberingStyle) \
+	PROPLIST(openSheet) \
+	NOARG(closeSheet) \
+	PROPLIST(openSheetRow) \
+	NOARG(closeSheetRow) \
+	PROPLIST(openSheetCell) \
+	NOARG(closeSheetCell) \
+	PROPLIST(defineChartStyle) \
+	PROPLIST(openChart) \
+	NOARG(closeChart) \
+	PROPLIST(openChartTextObject) \
+	NOARG(closeChartTextObject) \
+	PROPLIST(openChartPlotArea) \
+	NOARG(closeChartPlotArea) \
+	PROPLIST(insertChartAxis) \
+	PROPLIST(openChartSerie) \
+	NOARG(closeChartSerie)
+
+//! declares a method with a property list which overrides the interface's one
+#define WPS_DECLARE_PROPLIST_METHOD(name) void name(const librevenge::RVNGPropertyList &propList) final;
+//! declares a method without argument which overrides the interface's one
+#define WPS_DECLARE_NOARG_METHOD(name) void name() final;
+//! declares a method with a string which overrides the interface's one
+#define WPS_DECLARE_STRING_METHOD(name) void name(const librevenge::RVNGString &text) final;
+
+//! declares all the methods of librevenge::RVNGTextInterface
+#define WPS_DECLARE_TEXT_INTERFACE_METHODS \
+	WPS_TEXT_INTERFACE_METHODS(WPS_DECLARE_PROPLIST_METHOD, WPS_DECLARE_NOARG_METHOD, WPS_DECLARE_STRING_METHOD, \
+	                           WPS_DECLARE_PROPLIST_METHOD, WPS_DECLARE_NOARG_METHOD)
+//! declares all the methods of librevenge::RVNGSpreadsheetInterface
+#define WPS_DECLARE_SPREADSHEET_INTERFACE_METHODS \
+	WPS_TEXT_INTERFACE_METHODS(WPS_DECLARE_PROPLIST_METHOD, WPS_DECLARE_NOARG_METHOD, WPS_DECLARE_STRING_METHOD, \
+	                           WPS_IGNORE_METHOD, WPS_IGNORE_METHOD) \
+	WPS_SPREADSHEET_INTERFACE_METHODS(WPS_DECLARE_PROPLIST_METHOD, WPS_DECLARE_NOARG_METHOD)
+
+#endif
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
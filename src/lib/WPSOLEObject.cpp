@@ -77,16 +77,16 @@ bool WPSOLEObject::readMetafile(std::shared_ptr<WPSStream> stream, WPSEmbeddedOb
 		}
 		input->seek(pos+8, librevenge::RVNG_SEEK_SET);
 	}
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readData(input, static_cast<unsigned long>(endPos-pos-8), data))
+	if (!object.addZone(input, endPos-pos-8, "application/x-wmf"))
 	{
 		WPS_DEBUG_MSG(("WPSOLEObject::readMetafile: I can not find the picture\n"));
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
-	object.add(data,"application/x-wmf");
 #ifdef DEBUG_WITH_FILES
 	ascFile.skipZone(pos+8, endPos-1);
+	librevenge::RVNGBinaryData data;
+	object.getData(object.m_typeList.size()-1, data);
 	std::stringstream s;
 	static int fileId=0;
 	s << "PictMeta" << ++fileId << ".wmf";
@@ -113,14 +113,14 @@ bool WPSOLEObject::readWMF(std::shared_ptr<WPSStream> stream, WPSEmbeddedObject
 	input->seek(pos+6, librevenge::RVNG_SEEK_SET);
 	auto fSize = long(libwps::read32(input));
 	input->seek(pos, librevenge::RVNG_SEEK_SET);
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readData(input, static_cast<unsigned long>(2*fSize), data))
+	if (!object.addZone(input, 2*fSize, "application/x-wmf"))
 	{
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
 		return false;
 	}
-	object.add(data,"application/x-wmf");
 #ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	object.getData(object.m_typeList.size()-1, data);
 	std::stringstream f;
 	static volatile int actPict = 0;
 	f << "WMF" << actPict++ << ".wmf";
@@ -234,14 +234,14 @@ bool WPSOLEObject::readEmbeddedOLE(std::shared_ptr<WPSStream> stream, WPSEmbedde
 		ok=readMetafile(stream, object, actPos+long(dSz));
 	else
 	{
-		librevenge::RVNGBinaryData data;
-		if (!libwps::readData(input, dSz, data))
+		if (!object.addZone(input, long(dSz)))
 			ok=false;
 		else
 		{
-			object.add(data);
 #ifdef DEBUG_WITH_FILES
 			ascFile.skipZone(actPos, actPos+long(dSz)-1);
+			librevenge::RVNGBinaryData data;
+			object.getData(object.m_typeList.size()-1, data);
 			std::stringstream s;
 			static int fileId=0;
 			s << "PictOLEEmbedded" << ++fileId << ".pct";
@@ -311,14 +311,14 @@ bool WPSOLEObject::readStaticOLE(std::shared_ptr<WPSStream> stream, WPSEmbeddedO
 		ok=readMetafile(stream, object, actPos+long(dSz));
 	else
 	{
-		librevenge::RVNGBinaryData data;
-		if (!libwps::readData(input, dSz, data))
+		if (!object.addZone(input, long(dSz)))
 			ok=false;
 		else
 		{
-			object.add(data);
 #ifdef DEBUG_WITH_FILES
 			ascFile.skipZone(actPos, actPos+long(dSz)-1);
+			librevenge::RVNGBinaryData data;
+			object.getData(object.m_typeList.size()-1, data);
 			std::stringstream s;
 			static int fileId=0;
 			s << "PictOLEStatic" << ++fileId << ".pct";
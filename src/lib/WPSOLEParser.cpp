@@ -282,6 +282,13 @@ std::map<int,WPSEmbeddedObject> const &WPSOLEParser::getObjectsMap() const
 {
 	return m_state->m_idToObjectMap;
 }
+
+std::map<int,WPSEmbeddedObject> WPSOLEParser::releaseObjectsMap()
+{
+	std::map<int,WPSEmbeddedObject> res;
+	res.swap(m_state->m_idToObjectMap);
+	return res;
+}
 void WPSOLEParser::updateMetaData(librevenge::RVNGPropertyList &metaData) const
 {
 	librevenge::RVNGPropertyList::Iter i(m_state->m_metaData);
@@ -414,6 +421,13 @@ bool WPSOLEParser::parse(RVNGInputStreamPtr file)
 			if (!ok)
 				m_state->m_unknownOLEs.push_back(dOle.m_name);
 			asciiFile.reset();
+			// the sub stream is released now, so retrieve the representations' data from the file
+			for (size_t i=0; i<pict.m_inputList.size(); ++i)
+			{
+				if (pict.m_inputList[i]!=ole) continue;
+				pict.m_inputList[i]=file;
+				pict.m_entryList[i].setName(dOle.m_name);
+			}
 		}
 
 		if (!pict.isEmpty())
@@ -804,10 +818,10 @@ bool WPSOLEParser::readOlePres(RVNGInputStreamPtr &ip, WPSEmbeddedObject &obj, l
 
 	if (fSize == 0) return ip->isEnd();
 
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readData(ip, static_cast<unsigned long>(fSize), data)) return false;
-	obj.add(data);
+	if (!obj.addZone(ip, fSize)) return false;
 #ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	obj.getData(obj.m_entryList.size()-1, data);
 	std::stringstream s;
 	static int num=0;
 	s << "OlePress" << num++;
@@ -859,10 +873,10 @@ bool WPSOLEParser::readOle10Native(RVNGInputStreamPtr &ip, WPSEmbeddedObject &ob
 	ascii.addPos(0);
 	ascii.addNote(f.str().c_str());
 
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readData(ip, static_cast<unsigned long>(fSize), data)) return false;
-	obj.add(data);
+	if (!obj.addZone(ip, fSize)) return false;
 #ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	obj.getData(obj.m_entryList.size()-1, data);
 	std::stringstream s;
 	static int num=0;
 	s << "Ole10_" << num++ << ".bmp";
@@ -959,12 +973,12 @@ bool WPSOLEParser::readContents(RVNGInputStreamPtr &input,
 
 	if (ok)
 	{
-		librevenge::RVNGBinaryData data;
-		if (libwps::readData(input,static_cast<unsigned long>(size), data))
+		if (obj.addZone(input, size))
 		{
-			obj.add(data);
 			ascii.skipZone(actPos+4, actPos+size+4-1);
 #ifdef DEBUG_WITH_FILES
+			librevenge::RVNGBinaryData data;
+			obj.getData(obj.m_entryList.size()-1, data);
 			std::stringstream s;
 			static int fileId=0;
 			s << oleName << ++fileId << "cntents.pict";
@@ -1110,10 +1124,10 @@ bool WPSOLEParser::readCONTENTS(RVNGInputStreamPtr &input,
 	}
 
 	input->seek(4+hSize, librevenge::RVNG_SEEK_SET);
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readDataToEnd(input, data)) return false;
-	obj.add(data);
+	if (!obj.addZone(input, dataLength)) return false;
 #ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	obj.getData(obj.m_entryList.size()-1, data);
 	std::stringstream s;
 	static int fileId=0;
 	s << oleName << ++fileId << "Contents.pict";
@@ -1138,12 +1152,14 @@ bool WPSOLEParser::readMN0AndCheckWKS(RVNGInputStreamPtr &input, std::string con
 	bool ok=header->getKind()==WPS_SPREADSHEET;
 	if (!ok) return false;
 
+	input->seek(0, librevenge::RVNG_SEEK_END);
+	long dataLength=input->tell();
 	input->seek(0, librevenge::RVNG_SEEK_SET);
-	librevenge::RVNGBinaryData data;
-	if (!libwps::readDataToEnd(input, data))
+	if (!obj.addZone(input, dataLength, "image/wks-ods"))
 		return false;
-	obj.add(data,"image/wks-ods");
 #ifdef DEBUG_WITH_FILES
+	librevenge::RVNGBinaryData data;
+	obj.getData(obj.m_entryList.size()-1, data);
 	std::stringstream s;
 	static int fileId=0;
 	s << oleName << ++fileId << ".wks";
@@ -104,6 +104,8 @@ public:
 	std::vector<std::string> const &getNotParse() const;
 	//! returns the list of data positions which have been read
 	std::map<int,WPSEmbeddedObject> const &getObjectsMap() const;
+	//! returns the list of data positions which have been read and removes it from the parser
+	std::map<int,WPSEmbeddedObject> releaseObjectsMap();
 
 protected:
 	//! the summary information and the doc summary information
@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include "WPSProfiler.h"
+
+#include "WPSParseContext.h"
+
+WPSParseContext::WPSParseContext(libwps::WPSParseOptions const &options)
+	: m_options(options)
+	, m_startTime(std::chrono::steady_clock::now())
+	, m_numRecords(0)
+	, m_numCells(0)
+	, m_numCreatedCells(0)
+	, m_memory(0)
+	, m_numTimeChecks(0)
+	, m_limitExceeded(false)
+	, m_progressInput(nullptr)
+	, m_progressSize(0)
+	, m_progressNextPos(0)
+	, m_cancelled(false)
+	, m_profiler()
+{
+	if (options.m_profile)
+		m_profiler.reset(new WPSProfiler(*options.m_profile));
+}
+
+WPSParseContext::~WPSParseContext()
+{
+}
+
+void WPSParseContext::checkRecord()
+{
+	if (m_limitExceeded) throw libwps::LimitException();
+	auto const &limits=m_options.m_limits;
+	if (limits.m_maxRecords>0 && ++m_numRecords>limits.m_maxRecords)
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::checkRecord: the records limit is exceeded\n"));
+		limitExceeded();
+	}
+	checkTime();
+}
+
+void WPSParseContext::addCells(long num)
+{
+	if (m_limitExceeded) throw libwps::LimitException();
+	auto const &limits=m_options.m_limits;
+	if (limits.m_maxCells>0 && (m_numCells+=std::max(num,1L))>limits.m_maxCells)
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::addCells: the cells limit is exceeded\n"));
+		limitExceeded();
+	}
+	checkTime();
+}
+
+void WPSParseContext::addCreatedCells(long num)
+{
+	if (m_limitExceeded) throw libwps::LimitException();
+	auto const &limits=m_options.m_limits;
+	if (limits.m_maxCells>0 && num>0 && (m_numCreatedCells+=num)>limits.m_maxCells)
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::addCreatedCells: the cells limit is exceeded\n"));
+		limitExceeded();
+	}
+	checkTime();
+}
+
+void WPSParseContext::addMemory(long size)
+{
+	if (m_limitExceeded) throw libwps::LimitException();
+	auto const &limits=m_options.m_limits;
+	if (limits.m_maxMemory>0 && size>0 && (m_memory+=size)>limits.m_maxMemory)
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::addMemory: the memory limit is exceeded\n"));
+		limitExceeded();
+	}
+}
+
+void WPSParseContext::checkTime()
+{
+	// the clock is only read from time to time
+	if (m_options.m_limits.m_maxTime<=0 || ((++m_numTimeChecks)&0x3f)!=0)
+		return;
+	std::chrono::duration<double> const elapsed=std::chrono::steady_clock::now()-m_startTime;
+	if (elapsed.count()>m_options.m_limits.m_maxTime)
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::checkTime: the time limit is exceeded\n"));
+		limitExceeded();
+	}
+}
+
+void WPSParseContext::limitExceeded()
+{
+	m_limitExceeded=true;
+	throw libwps::LimitException();
+}
+
+void WPSParseContext::updateProgress(RVNGInputStreamPtr const &input)
+{
+	if (!input || !m_options.m_callback) return;
+	long pos=input->tell();
+	if (input.get()!=m_progressInput)
+	{
+		m_progressInput=input.get();
+		input->seek(0, librevenge::RVNG_SEEK_END);
+		m_progressSize=input->tell();
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		m_progressNextPos=0;
+	}
+	if (pos<m_progressNextPos) return;
+	// the callback is called each time a thousandth of the stream is read
+	m_progressNextPos=pos+std::max(m_progressSize/1000, 1L);
+	if (!m_options.m_callback->progress(pos, m_progressSize))
+	{
+		WPS_DEBUG_MSG(("WPSParseContext::updateProgress: the parsing is cancelled\n"));
+		m_cancelled=true;
+		throw libwps::CancelException();
+	}
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,170 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef WPS_PARSE_CONTEXT_H
+#define WPS_PARSE_CONTEXT_H
+
+#include <chrono>
+
+#include "libwps_internal.h"
+
+#include "libwps/libwps.h"
+
+class WPSProfiler;
+
+/** \brief a class used to store the data shared by the parsers and the listeners
+	which are created to parse a document: the parsing options, the resource counters, ...
+ */
+class WPSParseContext
+{
+public:
+	//! constructor
+	explicit WPSParseContext(libwps::WPSParseOptions const &options=libwps::WPSParseOptions());
+	//! destructor
+	~WPSParseContext();
+	//! returns the parsing options
+	libwps::WPSParseOptions const &getOptions() const
+	{
+		return m_options;
+	}
+	//! returns true if the embedded objects must not be read/sent
+	bool skipBinaryData() const
+	{
+		return m_options.m_skipBinaryData;
+	}
+	//! returns true if the spreadsheet's graphic zones must be skipped
+	bool skipGraphics() const
+	{
+		return m_options.m_skipGraphics;
+	}
+	//! returns true if the spreadsheet's chart zones must be skipped
+	bool skipCharts() const
+	{
+		return m_options.m_skipCharts;
+	}
+	//! returns true if the spreadsheet's comments must be skipped
+	bool skipComments() const
+	{
+		return m_options.m_skipComments;
+	}
+	//! returns true if the spreadsheet's style zones must be skipped
+	bool skipStyles() const
+	{
+		return m_options.m_skipStyles;
+	}
+	//! returns the maximum number of threads which can be used to decode some zones (at least 1)
+	int getNumThreads() const
+	{
+		return m_options.m_numThreads>1 ? m_options.m_numThreads : 1;
+	}
+
+	//
+	// limits
+	//
+
+	//! returns true if a resource limit was exceeded
+	bool isLimitExceeded() const
+	{
+		return m_limitExceeded;
+	}
+	/** increases the number of records and checks the records' and the time limits
+
+		\note this function is also called in the loops which do not read the input but whose
+		number of iterations is not bounded by the input size, ie. the loops over the tables' spans.
+		\note throws a libwps::LimitException if a limit is exceeded*/
+	void checkRecord();
+	/** increases the number of cells sent and checks the cells' and the time limits
+
+		\note throws a libwps::LimitException if a limit is exceeded*/
+	void addCells(long num);
+	/** increases the number of cells (or columns) created by a parser and checks the cells' and the time limits
+
+		\note the created cells are counted separately from the cells sent
+		\note throws a libwps::LimitException if a limit is exceeded*/
+	void addCreatedCells(long num);
+	/** increases the memory used by the data and checks the memory limit
+
+		\note throws a libwps::LimitException if a limit is exceeded*/
+	void addMemory(long size);
+
+	//
+	// progression
+	//
+
+	//! returns true if the parsing was cancelled by the callback
+	bool isCancelled() const
+	{
+		return m_cancelled;
+	}
+	/** calls the progress callback (from time to time) with the input's position
+
+		\note throws a libwps::CancelException if the parsing is cancelled*/
+	void checkProgress(RVNGInputStreamPtr const &input)
+	{
+		if (m_cancelled)
+			throw libwps::CancelException();
+		if (m_options.m_callback)
+			updateProgress(input);
+	}
+
+	//
+	// profiling
+	//
+
+	//! returns the profiler if the profiling is enabled or 0
+	WPSProfiler *getProfiler() const
+	{
+		return m_profiler.get();
+	}
+private:
+	WPSParseContext(WPSParseContext const &) = delete;
+	WPSParseContext &operator=(WPSParseContext const &) = delete;
+	//! checks the time limit (from time to time)
+	void checkTime();
+	//! sets the limit exceeded flag and throws a libwps::LimitException
+	void limitExceeded();
+	//! calls the callback if the input's position has sufficiently progressed
+	void updateProgress(RVNGInputStreamPtr const &input);
+	//! the parsing options
+	libwps::WPSParseOptions m_options;
+	//! the parsing start time
+	std::chrono::steady_clock::time_point m_startTime;
+	//! the number of records
+	long m_numRecords;
+	//! the number of cells sent
+	long m_numCells;
+	//! the number of cells created
+	long m_numCreatedCells;
+	//! the memory used by the data
+	long m_memory;
+	//! the number of calls to checkTime
+	unsigned long m_numTimeChecks;
+	//! a flag to know if a limit is exceeded
+	bool m_limitExceeded;
+	//! the last input whose progression is followed
+	librevenge::RVNGInputStream const *m_progressInput;
+	//! the size of the last input
+	long m_progressSize;
+	//! the next position which will trigger a call to the callback
+	long m_progressNextPos;
+	//! a flag to know if the parsing is cancelled
+	bool m_cancelled;
+	//! the profiler (if the profiling is enabled)
+	std::unique_ptr<WPSProfiler> m_profiler;
+};
+
+#endif /* WPS_PARSE_CONTEXT_H */
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -24,18 +24,25 @@
 
 #include "WPSEntry.h"
 #include "WPSHeader.h"
+#include "WPSParseContext.h"
 
 #include "WPSParser.h"
 
 WPSParser::WPSParser(RVNGInputStreamPtr &input, WPSHeaderPtr &header)
 	: m_input(input)
 	, m_header(header)
+	, m_parseContext()
 	, m_version(0)
 	, m_asciiFile()
 	, m_nameMultiMap()
 {
 	if (header)
+	{
 		m_version = header->getMajorVersion();
+		m_parseContext = header->getParseContext();
+	}
+	if (!m_parseContext)
+		m_parseContext = std::make_shared<WPSParseContext>();
 }
 
 WPSParser::~WPSParser()
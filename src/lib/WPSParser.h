@@ -53,6 +53,11 @@ protected:
 	{
 		return m_header;
 	}
+	//! returns the parsing context: options, ...
+	WPSParseContextPtr const &getParseContext() const
+	{
+		return m_parseContext;
+	}
 	int version() const
 	{
 		return m_version;
@@ -84,6 +89,8 @@ private:
 	RVNGInputStreamPtr m_input;
 	// the header
 	WPSHeaderPtr m_header;
+	// the parsing context
+	WPSParseContextPtr m_parseContext;
 	// the file version
 	int m_version;
 	//! the debug file
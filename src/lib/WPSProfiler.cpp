@@ -0,0 +1,375 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+#include "libwps_internal.h"
+
+#include "WPSProfiler.h"
+
+namespace WPSProfilerInternal
+{
+//! the profiler which is active in the actual thread: the last created
+static thread_local WPSProfiler *s_activeProfiler=nullptr;
+//! the last profiler's serial
+static std::atomic<unsigned long> s_lastSerial(0);
+//! the names of the memory subsystems
+static char const *s_memorySubsystemNames[]= {"other", "cells", "styles", "formulas", "oleStreams", "embeddedObjects", "listener"};
+}
+
+////////////////////////////////////////////////////////////
+// WPSProfiler
+////////////////////////////////////////////////////////////
+WPSProfiler::WPSProfiler(libwps::WPSParseProfile &profile)
+	: m_profile(profile)
+	, m_startTime(Clock::now())
+	, m_keyToStatisticMap()
+	, m_levelStack()
+	, m_emissionDepth(0)
+	, m_emissionStart()
+	, m_memorySubsystem(M_Other)
+	, m_memoryStatistics()
+	, m_memoryTotal()
+	, m_previousActiveProfiler(WPSProfilerInternal::s_activeProfiler)
+	, m_serial(++WPSProfilerInternal::s_lastSerial)
+{
+	WPSProfilerInternal::s_activeProfiler=this;
+}
+
+WPSProfiler::~WPSProfiler()
+{
+	// the allocations made to send the statistics are not registered
+	if (WPSProfilerInternal::s_activeProfiler==this)
+		WPSProfilerInternal::s_activeProfiler=m_previousActiveProfiler;
+	if (!m_levelStack.empty())
+	{
+		WPS_DEBUG_MSG(("WPSProfiler::~WPSProfiler: some zones are not closed\n"));
+	}
+	try
+	{
+		for (auto const &it : m_keyToStatisticMap)
+		{
+			auto const &key=it.first;
+			auto const &stat=it.second;
+			std::string name(key.m_name);
+			if (key.m_type>=0)
+			{
+				char buffer[20];
+				std::snprintf(buffer, sizeof(buffer), "0x%x", unsigned(key.m_type));
+				name=buffer;
+			}
+			m_profile.addZone(key.m_parser.c_str(), name.c_str(), stat.m_count, stat.m_bytes, stat.m_decodeTime, stat.m_emitTime);
+		}
+		if (m_memoryTotal.m_numAllocations)
+		{
+			static_assert(sizeof(WPSProfilerInternal::s_memorySubsystemNames)/sizeof(char const *)==M_NumSubsystems,
+			              "the subsystem names are not defined");
+			for (int i=0; i<M_NumSubsystems; ++i)
+			{
+				auto const &stat=m_memoryStatistics[i];
+				if (stat.m_numAllocations)
+					m_profile.addMemory(WPSProfilerInternal::s_memorySubsystemNames[i], long(stat.m_numAllocations), long(stat.m_bytes), long(stat.m_peak));
+			}
+			m_profile.addMemory("total", long(m_memoryTotal.m_numAllocations), long(m_memoryTotal.m_bytes), long(m_memoryTotal.m_peak));
+		}
+		std::chrono::duration<double> const elapsed=Clock::now()-m_startTime;
+		m_profile.addParsing(elapsed.count());
+	}
+	catch (...)
+	{
+		WPS_DEBUG_MSG(("WPSProfiler::~WPSProfiler: can not send the statistics\n"));
+	}
+}
+
+void WPSProfiler::openZone(char const *parser, int type, std::string const &name, long bytes)
+{
+	auto &stat=m_keyToStatisticMap[Key(parser, type, name)];
+	++stat.m_count;
+	if (bytes>0) stat.m_bytes+=bytes;
+	m_levelStack.push_back(Level(stat, Clock::now()));
+}
+
+void WPSProfiler::closeZone()
+{
+	if (m_levelStack.empty())
+	{
+		WPS_DEBUG_MSG(("WPSProfiler::closeZone: no zone is opened\n"));
+		return;
+	}
+	std::chrono::duration<double> const elapsed=Clock::now()-m_levelStack.back().m_start;
+	auto const &level=m_levelStack.back();
+	level.m_statistic->m_decodeTime+=std::max(0., elapsed.count()-level.m_childTime-level.m_emitTime);
+	level.m_statistic->m_emitTime+=level.m_emitTime;
+	m_levelStack.pop_back();
+	if (!m_levelStack.empty())
+		m_levelStack.back().m_childTime+=elapsed.count();
+}
+
+void WPSProfiler::openEmission()
+{
+	// the listener's functions can call each other, only measure the first call
+	if (m_emissionDepth++==0)
+		m_emissionStart=Clock::now();
+}
+
+void WPSProfiler::closeEmission()
+{
+	if (m_emissionDepth<=0 || --m_emissionDepth>0)
+		return;
+	std::chrono::duration<double> const elapsed=Clock::now()-m_emissionStart;
+	if (!m_levelStack.empty())
+	{
+		m_levelStack.back().m_emitTime+=elapsed.count();
+		return;
+	}
+	auto &stat=m_keyToStatisticMap[Key("Listener", -1, "send")];
+	++stat.m_count;
+	stat.m_emitTime+=elapsed.count();
+}
+
+unsigned long WPSProfiler::memoryAllocated(unsigned long size)
+{
+	WPSProfiler *profiler=WPSProfilerInternal::s_activeProfiler;
+	if (!profiler) return 0;
+	auto const subsystem=profiler->m_memorySubsystem;
+	profiler->m_memoryStatistics[subsystem].allocate(size);
+	profiler->m_memoryTotal.allocate(size);
+	// the token: the profiler's serial and the subsystem+1 in the 3 lowest bits
+	return (profiler->m_serial<<3)|static_cast<unsigned long>(subsystem+1);
+}
+
+void WPSProfiler::memoryFreed(unsigned long token, unsigned long size)
+{
+	WPSProfiler *profiler=WPSProfilerInternal::s_activeProfiler;
+	// the block is allocated before the profiler or by another profiler
+	if (!token || !profiler || (token>>3)!=profiler->m_serial) return;
+	auto const subsystem=int(token&7)-1;
+	if (subsystem<0 || subsystem>=M_NumSubsystems) return;
+	auto &stat=profiler->m_memoryStatistics[subsystem];
+	stat.m_current-=std::min(stat.m_current, size);
+	profiler->m_memoryTotal.m_current-=std::min(profiler->m_memoryTotal.m_current, size);
+}
+
+////////////////////////////////////////////////////////////
+// WPSParseProfile
+////////////////////////////////////////////////////////////
+namespace libwps
+{
+//! the internal data of a WPSParseProfile
+struct WPSParseProfile::Data
+{
+	//! the statistics of a zone
+	struct Zone
+	{
+		//! constructor
+		Zone()
+			: m_count(0)
+			, m_bytes(0)
+			, m_decodeTime(0)
+			, m_emitTime(0)
+		{
+		}
+		//! the number of zones
+		long m_count;
+		//! the number of bytes
+		long m_bytes;
+		//! the decoding time
+		double m_decodeTime;
+		//! the emission time
+		double m_emitTime;
+	};
+	//! the memory statistics of a subsystem
+	struct Memory
+	{
+		//! constructor
+		Memory()
+			: m_numAllocations(0)
+			, m_bytes(0)
+			, m_peak(0)
+		{
+		}
+		//! the number of allocations
+		long m_numAllocations;
+		//! the allocated size
+		long m_bytes;
+		//! the maximal peak of the parsings
+		long m_peak;
+	};
+	//! constructor
+	Data()
+		: m_numParsings(0)
+		, m_totalTime(0)
+		, m_nameToZoneMap()
+		, m_nameToMemoryMap()
+	{
+	}
+	//! the number of parsings
+	int m_numParsings;
+	//! the total time
+	double m_totalTime;
+	//! a map (parser, zone) to statistics
+	std::map<std::pair<std::string,std::string>, Zone> m_nameToZoneMap;
+	//! a map subsystem to memory statistics
+	std::map<std::string, Memory> m_nameToMemoryMap;
+};
+}
+
+namespace WPSProfilerInternal
+{
+//! appends a string in JSON format
+static void appendJSONString(librevenge::RVNGString &res, std::string const &str)
+{
+	res.append('"');
+	for (auto c : str)
+	{
+		if (c=='"' || c=='\\')
+		{
+			res.append('\\');
+			res.append(c);
+		}
+		else if (static_cast<unsigned char>(c)<0x20)
+		{
+			librevenge::RVNGString code;
+			code.sprintf("\\u%04x", unsigned(static_cast<unsigned char>(c)));
+			res.append(code);
+		}
+		else
+			res.append(c);
+	}
+	res.append('"');
+}
+
+//! appends a double in JSON: with a dot whatever the locale is
+static void appendJSONDouble(librevenge::RVNGString &res, double value)
+{
+	std::ostringstream s;
+	s.imbue(std::locale::classic());
+	s << std::fixed << std::setprecision(6) << value;
+	res.append(s.str().c_str());
+}
+}
+
+libwps::WPSParseProfile::WPSParseProfile()
+	: m_data(new Data)
+{
+}
+
+libwps::WPSParseProfile::~WPSParseProfile()
+{
+	delete m_data;
+}
+
+void libwps::WPSParseProfile::clear()
+{
+	*m_data=Data();
+}
+
+bool libwps::WPSParseProfile::empty() const
+{
+	return m_data->m_nameToZoneMap.empty() && m_data->m_nameToMemoryMap.empty();
+}
+
+void libwps::WPSParseProfile::addZone(char const *parser, char const *zone, long count, long bytes, double decodeTime, double emitTime)
+{
+	auto &data=m_data->m_nameToZoneMap[std::make_pair(std::string(parser ? parser : ""), std::string(zone ? zone : ""))];
+	data.m_count+=count;
+	data.m_bytes+=bytes;
+	data.m_decodeTime+=decodeTime;
+	data.m_emitTime+=emitTime;
+}
+
+void libwps::WPSParseProfile::addMemory(char const *subsystem, long numAllocations, long bytes, long peak)
+{
+	auto &data=m_data->m_nameToMemoryMap[subsystem ? subsystem : ""];
+	data.m_numAllocations+=numAllocations;
+	data.m_bytes+=bytes;
+	data.m_peak=std::max(data.m_peak, peak);
+}
+
+unsigned long libwps::WPSParseProfile::memoryAllocated(unsigned long size)
+{
+	return WPSProfiler::memoryAllocated(size);
+}
+
+void libwps::WPSParseProfile::memoryFreed(unsigned long token, unsigned long size)
+{
+	WPSProfiler::memoryFreed(token, size);
+}
+
+void libwps::WPSParseProfile::addParsing(double time)
+{
+	++m_data->m_numParsings;
+	m_data->m_totalTime+=time;
+}
+
+librevenge::RVNGString libwps::WPSParseProfile::getJSON() const
+{
+	typedef std::map<std::pair<std::string,std::string>, Data::Zone>::const_iterator Iterator;
+	std::vector<Iterator> zones;
+	for (auto it=m_data->m_nameToZoneMap.begin(); it!=m_data->m_nameToZoneMap.end(); ++it)
+		zones.push_back(it);
+	std::stable_sort(zones.begin(), zones.end(), [](Iterator const &a, Iterator const &b)
+	{
+		return a->second.m_decodeTime+a->second.m_emitTime > b->second.m_decodeTime+b->second.m_emitTime;
+	});
+
+	librevenge::RVNGString res, line;
+	line.sprintf("{\n\t\"parsings\": %d,\n\t\"totalTime\": ", m_data->m_numParsings);
+	res.append(line);
+	WPSProfilerInternal::appendJSONDouble(res, m_data->m_totalTime);
+	res.append(",\n\t\"zones\": [");
+	bool first=true;
+	for (auto const &it : zones)
+	{
+		res.append(first ? "\n\t\t{ \"parser\": " : ",\n\t\t{ \"parser\": ");
+		first=false;
+		WPSProfilerInternal::appendJSONString(res, it->first.first);
+		res.append(", \"zone\": ");
+		WPSProfilerInternal::appendJSONString(res, it->first.second);
+		auto const &zone=it->second;
+		line.sprintf(", \"count\": %ld, \"bytes\": %ld, \"decodeTime\": ", zone.m_count, zone.m_bytes);
+		res.append(line);
+		WPSProfilerInternal::appendJSONDouble(res, zone.m_decodeTime);
+		res.append(", \"emitTime\": ");
+		WPSProfilerInternal::appendJSONDouble(res, zone.m_emitTime);
+		res.append(" }");
+	}
+	res.append(first ? "]" : "\n\t]");
+	if (!m_data->m_nameToMemoryMap.empty())
+	{
+		res.append(",\n\t\"memory\": [");
+		first=true;
+		for (auto const &it : m_data->m_nameToMemoryMap)
+		{
+			res.append(first ? "\n\t\t{ \"subsystem\": " : ",\n\t\t{ \"subsystem\": ");
+			first=false;
+			WPSProfilerInternal::appendJSONString(res, it.first);
+			line.sprintf(", \"allocations\": %ld, \"bytes\": %ld, \"peak\": %ld }",
+			             it.second.m_numAllocations, it.second.m_bytes, it.second.m_peak);
+			res.append(line);
+		}
+		res.append("\n\t]");
+	}
+	res.append("\n}\n");
+	return res;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
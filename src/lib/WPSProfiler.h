@@ -0,0 +1,286 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* libwps
+ * Version: MPL 2.0 / LGPLv2.1+
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For minor contributions see the git repository.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU Lesser General Public License Version 2.1 or later
+ * (LGPLv2.1+), in which case the provisions of the LGPLv2.1+ are
+ * applicable instead of those above.
+ */
+
+#ifndef WPS_PROFILER_H
+#define WPS_PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "libwps/libwps.h"
+
+/** \brief a class used to measure the time spent by the parsers in each zone
+	and by the listeners to send the zones' content to the interface.
+
+	It also attributes the memory allocated during the parsing to some
+	subsystems (cells, styles, ...) if the application registers its
+	allocations with WPSParseProfile::memoryAllocated.
+
+	\note the profiler is only created if WPSParseOptions::m_profile is set, so
+	the guards Zone, Emission and Memory only test a null pointer when profiling is disabled.
+ */
+class WPSProfiler
+{
+public:
+	//! the subsystems to which the allocated memory is attributed
+	enum MemorySubsystem { M_Other=0, M_Cells, M_Styles, M_Formulas, M_OLEStreams, M_EmbeddedObjects, M_Listener, M_NumSubsystems };
+
+	//! constructor
+	explicit WPSProfiler(libwps::WPSParseProfile &profile);
+	//! destructor: sends the statistics to the profile
+	~WPSProfiler();
+
+	/** a guard used to profile a zone: the zone is opened by the constructor
+		and closed by the destructor. The zones can be nested, the decoding time
+		of a zone does not include the time spent in its sub zones.
+	 */
+	class Zone
+	{
+	public:
+		//! constructor to profile a zone identified by a type
+		Zone(WPSProfiler *profiler, char const *parser, int type, long bytes)
+			: m_profiler(profiler)
+		{
+			if (m_profiler) m_profiler->openZone(parser, type, "", bytes);
+		}
+		//! constructor to profile a named zone
+		Zone(WPSProfiler *profiler, char const *parser, std::string const &name, long bytes)
+			: m_profiler(profiler)
+		{
+			if (m_profiler) m_profiler->openZone(parser, -1, name, bytes);
+		}
+		//! destructor
+		~Zone()
+		{
+			if (m_profiler) m_profiler->closeZone();
+		}
+	private:
+		Zone(Zone const &) = delete;
+		Zone &operator=(Zone const &) = delete;
+		//! the profiler
+		WPSProfiler *m_profiler;
+	};
+
+	/** a guard used to measure the time spent to send some content to the interface.
+		This time is added to the actual zone (or to a "send" zone if no zone is opened).
+	 */
+	class Emission
+	{
+	public:
+		//! constructor
+		explicit Emission(WPSProfiler *profiler)
+			: m_profiler(profiler)
+			, m_previousSubsystem(M_Other)
+		{
+			if (!m_profiler) return;
+			m_profiler->openEmission();
+			m_previousSubsystem=m_profiler->setMemorySubsystem(M_Listener);
+		}
+		//! destructor
+		~Emission()
+		{
+			if (!m_profiler) return;
+			m_profiler->setMemorySubsystem(m_previousSubsystem);
+			m_profiler->closeEmission();
+		}
+	private:
+		Emission(Emission const &) = delete;
+		Emission &operator=(Emission const &) = delete;
+		//! the profiler
+		WPSProfiler *m_profiler;
+		//! the previous memory subsystem
+		MemorySubsystem m_previousSubsystem;
+	};
+
+	/** a guard used to attribute the memory allocated in a scope to a subsystem.
+		The guards can be nested, the innermost subsystem is used.
+	 */
+	class Memory
+	{
+	public:
+		//! constructor
+		Memory(WPSProfiler *profiler, MemorySubsystem subsystem)
+			: m_profiler(profiler)
+			, m_previousSubsystem(M_Other)
+		{
+			if (m_profiler) m_previousSubsystem=m_profiler->setMemorySubsystem(subsystem);
+		}
+		//! destructor
+		~Memory()
+		{
+			if (m_profiler) m_profiler->setMemorySubsystem(m_previousSubsystem);
+		}
+	private:
+		Memory(Memory const &) = delete;
+		Memory &operator=(Memory const &) = delete;
+		//! the profiler
+		WPSProfiler *m_profiler;
+		//! the previous subsystem
+		MemorySubsystem m_previousSubsystem;
+	};
+
+	/** registers an allocation in the profiler which is active in the
+		actual thread, returns a token which must be given to memoryFreed
+		or 0 if the allocation is not registered */
+	static unsigned long memoryAllocated(unsigned long size);
+	//! registers that a memory block is freed
+	static void memoryFreed(unsigned long token, unsigned long size);
+
+protected:
+	//! the clock
+	typedef std::chrono::steady_clock Clock;
+	//! opens a zone
+	void openZone(char const *parser, int type, std::string const &name, long bytes);
+	//! closes the last opened zone
+	void closeZone();
+	//! starts an emission
+	void openEmission();
+	//! ends an emission
+	void closeEmission();
+	//! sets the actual memory subsystem, returns the previous one
+	MemorySubsystem setMemorySubsystem(MemorySubsystem subsystem)
+	{
+		MemorySubsystem previous=m_memorySubsystem;
+		m_memorySubsystem=subsystem;
+		return previous;
+	}
+
+	//! the key used to identify a zone: the parser and a type or a name
+	struct Key
+	{
+		//! constructor
+		Key(char const *parser, int type, std::string const &name)
+			: m_parser(parser ? parser : "")
+			, m_type(type)
+			, m_name(name)
+		{
+		}
+		//! operator<
+		bool operator<(Key const &key) const
+		{
+			int cmp=m_parser.compare(key.m_parser);
+			if (cmp) return cmp<0;
+			if (m_type!=key.m_type) return m_type<key.m_type;
+			return m_name<key.m_name;
+		}
+		//! the parser's name
+		std::string m_parser;
+		//! the zone's type or -1
+		int m_type;
+		//! the zone's name
+		std::string m_name;
+	};
+	//! the statistics of a zone
+	struct Statistic
+	{
+		//! constructor
+		Statistic()
+			: m_count(0)
+			, m_bytes(0)
+			, m_decodeTime(0)
+			, m_emitTime(0)
+		{
+		}
+		//! the number of zones
+		long m_count;
+		//! the number of bytes
+		long m_bytes;
+		//! the decoding time
+		double m_decodeTime;
+		//! the emission time
+		double m_emitTime;
+	};
+	//! an opened zone
+	struct Level
+	{
+		//! constructor
+		Level(Statistic &stat, Clock::time_point const &start)
+			: m_statistic(&stat)
+			, m_start(start)
+			, m_childTime(0)
+			, m_emitTime(0)
+		{
+		}
+		//! the zone's statistic
+		Statistic *m_statistic;
+		//! the opening time
+		Clock::time_point m_start;
+		//! the time spent in the sub zones
+		double m_childTime;
+		//! the time spent to send data
+		double m_emitTime;
+	};
+	//! the memory statistics of a subsystem
+	struct MemoryStatistic
+	{
+		//! constructor
+		MemoryStatistic()
+			: m_numAllocations(0)
+			, m_bytes(0)
+			, m_current(0)
+			, m_peak(0)
+		{
+		}
+		//! adds an allocation
+		void allocate(unsigned long size)
+		{
+			++m_numAllocations;
+			m_bytes+=size;
+			m_current+=size;
+			if (m_current>m_peak) m_peak=m_current;
+		}
+		//! the number of allocations
+		unsigned long m_numAllocations;
+		//! the allocated size
+		unsigned long m_bytes;
+		//! the size actually allocated
+		unsigned long m_current;
+		//! the peak of the size allocated
+		unsigned long m_peak;
+	};
+
+	//! the profile
+	libwps::WPSParseProfile &m_profile;
+	//! the creation time
+	Clock::time_point m_startTime;
+	//! a map key to statistic
+	std::map<Key, Statistic> m_keyToStatisticMap;
+	//! the stack of opened zones
+	std::vector<Level> m_levelStack;
+	//! the number of opened emissions
+	int m_emissionDepth;
+	//! the start time of the first opened emission
+	Clock::time_point m_emissionStart;
+	//! the actual memory subsystem
+	MemorySubsystem m_memorySubsystem;
+	//! the memory statistics of each subsystem
+	MemoryStatistic m_memoryStatistics[M_NumSubsystems];
+	//! the memory statistics of all the subsystems
+	MemoryStatistic m_memoryTotal;
+	//! the profiler which was active in this thread when this profiler was created
+	WPSProfiler *m_previousActiveProfiler;
+	//! an identifier used to check the tokens
+	unsigned long m_serial;
+
+private:
+	WPSProfiler(WPSProfiler const &) = delete;
+	WPSProfiler &operator=(WPSProfiler const &) = delete;
+};
+
+#endif /* WPS_PROFILER_H */
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
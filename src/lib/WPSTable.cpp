@@ -29,11 +29,13 @@
  *
  */
 
+#include <algorithm>
 #include <iostream>
-#include <set>
+#include <utility>
 
 #include "WPSContentListener.h"
 #include "WPSCell.h"
+#include "WPSParseContext.h"
 
 #include "WPSTable.h"
 
@@ -119,7 +121,7 @@ WPSCellPtr WPSTable::getCell(int id)
 
 ////////////////////////////////////////////////////////////
 // build the table structure
-bool WPSTable::buildStructures()
+bool WPSTable::buildStructures(WPSParseContext *context)
 {
 	if (m_colsSize.size())
 		return true;
@@ -128,19 +130,21 @@ bool WPSTable::buildStructures()
 	std::vector<float> listPositions[2];
 	for (int dim = 0; dim < 2; dim++)
 	{
+		// sort the cells' limits, then sweep them to merge the near limits
 		WPSCell::Compare compareFunction(dim);
-		std::set<WPSCell::Compare::Point,
-		    WPSCell::Compare> set(compareFunction);
+		std::vector<WPSCell::Compare::Point> points;
+		points.reserve(2*nCells);
 		for (size_t c = 0; c < nCells; c++)
 		{
-			set.insert(WPSCell::Compare::Point(0, m_cellsList[c].get()));
-			set.insert(WPSCell::Compare::Point(1, m_cellsList[c].get()));
+			points.push_back(WPSCell::Compare::Point(0, m_cellsList[c].get()));
+			points.push_back(WPSCell::Compare::Point(1, m_cellsList[c].get()));
 		}
+		std::sort(points.begin(), points.end(), compareFunction);
 
-		std::vector<float> positions;
+		std::vector<float> &positions = listPositions[dim];
 		float maxPosiblePos=0;
 		int actCell = -1;
-		for (auto it : set)
+		for (auto const &it : points)
 		{
 			float pos = it.getPos(dim);
 			if (actCell < 0 || pos > maxPosiblePos)
@@ -152,7 +156,6 @@ bool WPSTable::buildStructures()
 			if (it.m_which == 0 && it.getPos(dim)-2.0f < maxPosiblePos)
 				maxPosiblePos = pos;
 		}
-		listPositions[dim] = positions;
 	}
 	std::vector<int> numYSet(listPositions[1].size(), 0);
 	std::vector<int> numYUnset(listPositions[1].size(), 0);
@@ -166,19 +169,17 @@ bool WPSTable::buildStructures()
 			              };
 			std::vector<float> &pos = listPositions[dim];
 			size_t numPos = pos.size();
-			size_t i = 0;
-			while (i+1 < numPos && pos[i+1] < pt[0])
-				i++;
-			while (i+1 < numPos && (pos[i]+pos[i+1])/2 < pt[0])
-				i++;
-			if (i+1 > numPos)
+			if (numPos == 0)
 			{
 				WPS_DEBUG_MSG(("WPSTable::buildStructures: impossible to find cell position !!!\n"));
 				return false;
 			}
-			cellPos[dim] = int(i);
-			while (i+1 < numPos && pos[i+1] < pt[1])
+			// the positions are sorted, so look for the last limit before the cell
+			auto i = size_t(std::lower_bound(pos.begin()+1, pos.end(), pt[0])-pos.begin())-1;
+			while (i+1 < numPos && (pos[i]+pos[i+1])/2 < pt[0])
 				i++;
+			cellPos[dim] = int(i);
+			i = size_t(std::lower_bound(pos.begin()+long(i)+1, pos.end(), pt[1])-pos.begin())-1;
 			if (i+1 < numPos && (pos[i]+pos[i+1])/2 < pt[1])
 				i++;
 			spanCell[dim] = int(i)-cellPos[dim];
@@ -207,6 +208,8 @@ bool WPSTable::buildStructures()
 		{
 			for (int x = cellPos[0]; x < cellPos[0]+spanCell[0]; x++)
 			{
+				// the spans are not bounded by the input size
+				if (context) context->checkRecord();
 				if (cell->isVerticalSet())
 					numYSet[size_t(cellPos[1]+spanCell[1]-1)]++;
 				else
@@ -240,7 +243,8 @@ bool WPSTable::buildStructures()
 // try to send the table
 bool WPSTable::sendTable(WPSContentListenerPtr listener)
 {
-	if (!buildStructures())
+	WPSParseContext *context=listener ? listener->getParseContext().get() : nullptr;
+	if (!buildStructures(context))
 		return false;
 	if (!listener)
 		return true;
@@ -249,7 +253,8 @@ bool WPSTable::sendTable(WPSContentListenerPtr listener)
 	size_t numRows = m_rowsSize.size();
 	if (!numCols || !numRows)
 		return false;
-	std::vector<int> cellsId(numCols*numRows, -1);
+	// for each row, the list of (column, cell id) where a cell begins or -2 if the position is covered by a cell
+	std::vector<std::vector<std::pair<int,int> > > rowCellsList(numRows);
 	size_t nCells = m_cellsList.size();
 	for (size_t c = 0; c < nCells; c++)
 	{
@@ -266,34 +271,39 @@ bool WPSTable::sendTable(WPSContentListenerPtr listener)
 			}
 			for (int y = pos[1]; y < pos[1]+span[1]; y++)
 			{
+				if (context) context->checkRecord();
 				if (y >= int(numRows))
 				{
 					WPS_DEBUG_MSG(("WPSTable::sendTable: y is too big !!!\n"));
 					return false;
 				}
-				auto tablePos = size_t(y*int(numCols)+x);
-				if (cellsId[tablePos] != -1)
-				{
-					WPS_DEBUG_MSG(("WPSTable::sendTable: cells is used!!!\n"));
-					return false;
-				}
-				if (x == pos[0] && y == pos[1])
-					cellsId[tablePos] = int(c);
-				else
-					cellsId[tablePos] = -2;
+				rowCellsList[size_t(y)].push_back(std::make_pair(x, (x == pos[0] && y == pos[1]) ? int(c) : -2));
 			}
 		}
 	}
+	for (auto &rowCells : rowCellsList)
+	{
+		std::sort(rowCells.begin(), rowCells.end());
+		for (size_t i = 1; i < rowCells.size(); i++)
+		{
+			if (rowCells[i].first != rowCells[i-1].first) continue;
+			WPS_DEBUG_MSG(("WPSTable::sendTable: cells is used!!!\n"));
+			return false;
+		}
+	}
 
 	listener->openTable(m_colsSize, librevenge::RVNG_POINT);
 	WPSListenerPtr listen=listener;
 	for (size_t r = 0; r < numRows; r++)
 	{
 		listener->openTableRow(m_rowsSize[r], librevenge::RVNG_POINT);
+		auto const &rowCells = rowCellsList[r];
+		auto cellIt = rowCells.begin();
 		for (size_t c = 0; c < numCols; c++)
 		{
-			size_t tablePos = r*numCols+c;
-			int id = cellsId[tablePos];
+			int id = -1;
+			if (cellIt != rowCells.end() && cellIt->first == int(c))
+				id = cellIt++->second;
 			if (id == -1)
 				listener->addEmptyTableCell(Vec2i(int(c), int(r)));
 			if (id < 0)
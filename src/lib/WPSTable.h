@@ -186,8 +186,10 @@ public:
 	bool sendAsText(WPSContentListenerPtr listener);
 
 protected:
-	//! create the correspondance list, ...
-	bool buildStructures();
+	/** create the correspondance list, ...
+
+		\note if context is set, the work done by the loops over the cells' spans is checked */
+	bool buildStructures(WPSParseContext *context);
 
 	/** the list of cells */
 	std::vector<WPSCellPtr> m_cellsList;
@@ -26,9 +26,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <utility>
+
 #include "libwps_internal.h"
 
 #include "WPSParser.h"
+#include "WPSParseContext.h"
+#include "WPSProfiler.h"
 
 #include "WPSTextParser.h"
 
@@ -39,8 +44,9 @@ WPSTextParser::WPSTextParser(WPSParser &parser, RVNGInputStreamPtr &input)
 	: m_version(0)
 	, m_input(input)
 	, m_mainParser(parser)
-	, m_textPositions(),
-	  m_FODList()
+	, m_textPositions()
+	, m_FODList()
+	, m_FODActiveIdsList()
 	, m_asciiFile(parser.ascii())
 {
 }
@@ -65,6 +71,11 @@ WPSParser::NameMultiMap const &WPSTextParser::getNameEntryMap() const
 	return m_mainParser.getNameEntryMap();
 }
 
+WPSParseContextPtr const &WPSTextParser::getParseContext() const
+{
+	return m_mainParser.getParseContext();
+}
+
 ////////////////////////////////////////////////////////////
 // read data
 ////////////////////////////////////////////////////////////
@@ -78,6 +89,8 @@ bool WPSTextParser::readFDP(WPSEntry const &entry,
 		WPS_DEBUG_MSG(("WPSTextParser::readFDP: warning: FDP entry unintialized\n"));
 		return false;
 	}
+	getParseContext()->checkRecord();
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), version()<5 ? "WPS4" : "WPS8", entry.type(), entry.length());
 
 	entry.setParsed();
 	long page_offset = entry.begin();
@@ -273,4 +286,36 @@ std::vector<WPSTextParser::DataFOD> WPSTextParser::mergeSortedFODLists
 	}
 	return res;
 }
+
+void WPSTextParser::setFODList(std::vector<DataFOD> fods)
+{
+	m_FODList=std::move(fods);
+	m_FODActiveIdsList.resize(m_FODList.size());
+	int fontId=-1, paragraphId=-1;
+	for (size_t i=0; i<m_FODList.size(); ++i)
+	{
+		if (m_FODList[i].m_type==DataFOD::ATTR_TEXT)
+			fontId=m_FODList[i].m_id;
+		else if (m_FODList[i].m_type==DataFOD::ATTR_PARAG)
+			paragraphId=m_FODList[i].m_id;
+		m_FODActiveIdsList[i]=std::make_pair(fontId, paragraphId);
+	}
+}
+
+std::vector<WPSTextParser::DataFOD>::const_iterator WPSTextParser::findFOD(long pos, int &fontId, int &paragraphId) const
+{
+	auto it=std::lower_bound(m_FODList.begin(), m_FODList.end(), pos,
+	                         [](DataFOD const &fod, long p)
+	{
+		return fod.m_pos<p;
+	});
+	fontId=paragraphId=-1;
+	if (it!=m_FODList.begin() && m_FODActiveIdsList.size()==m_FODList.size())
+	{
+		auto const &ids=m_FODActiveIdsList[size_t(it-m_FODList.begin())-1];
+		fontId=ids.first;
+		paragraphId=ids.second;
+	}
+	return it;
+}
 /* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
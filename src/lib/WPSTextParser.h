@@ -61,6 +61,9 @@ protected:
 	//! returns the map type->entry
 	std::multimap<std::string, WPSEntry> const &getNameEntryMap() const;
 
+	//! returns the parsing context
+	WPSParseContextPtr const &getParseContext() const;
+
 protected:
 	//! structure which retrieves data information which correspond to a text position
 	struct DataFOD
@@ -94,6 +97,15 @@ protected:
 	    \return a list of attribute */
 	std::vector<DataFOD> mergeSortedFODLists
 	(std::vector<DataFOD> const &lst1, std::vector<DataFOD> const &lst2) const;
+	//! sets the sorted list of FOD and updates the ids which are active after each FOD
+	void setFODList(std::vector<DataFOD> fods);
+	/** finds in O(log n) the first FOD whose position is greater or equal to pos.
+
+	    \param pos the text position
+	    \param fontId is set to the id of the last ATTR_TEXT before pos (-1 if none)
+	    \param paragraphId is set to the id of the last ATTR_PARAG before pos (-1 if none)
+	    \return an iterator in m_FODList */
+	std::vector<DataFOD>::const_iterator findFOD(long pos, int &fontId, int &paragraphId) const;
 
 	/** callback when a new attribute is found in an FDPP/FDPC entry
 	 *
@@ -130,8 +142,10 @@ protected:
 	WPSParser &m_mainParser;
 	//! an entry which corresponds to the complete text zone
 	WPSEntry m_textPositions;
-	//! the list of a FOD
+	//! the list of a FOD, sorted by position (must be modified with setFODList)
 	std::vector<DataFOD> m_FODList;
+	//! the font and paragraph ids which are active after each FOD of m_FODList
+	std::vector<std::pair<int,int> > m_FODActiveIdsList;
 	//! the ascii file
 	libwps::DebugFile &m_asciiFile;
 };
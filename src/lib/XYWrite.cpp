@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <sstream>
 
 #include <librevenge-stream/librevenge-stream.h>
@@ -36,7 +37,9 @@
 #include "WPSHeader.h"
 #include "WPSPageSpan.h"
 #include "WPSParagraph.h"
+#include "WPSParseContext.h"
 #include "WPSPosition.h"
+#include "WPSProfiler.h"
 #include "WPSTable.h"
 #include "WPSTextSubDocument.h"
 
@@ -102,6 +105,13 @@ Cell::~Cell()
 {
 }
 
+/** returns true if a character of a text zone must be treated separately:
+	command delimiters, end zone marker, binary character, tabulation, end of line, ... */
+inline bool isSpecialCharacter(unsigned char c)
+{
+	return c<0x1f || c==0xae || c==0xaf || c==0xfa || c==0xff;
+}
+
 //! a structure used to store a format
 struct Format
 {
@@ -135,6 +145,18 @@ struct Format
 	{
 		return upperCase(m_string);
 	}
+	//! returns the code of the two first characters of the main string in uppercase (or 0)
+	int shortCode() const
+	{
+		if (m_string.size()<2)
+			return 0;
+		return getCode(char(std::toupper(m_string[0])), char(std::toupper(m_string[1])));
+	}
+	//! returns the code corresponding to a two characters command
+	static constexpr int getCode(char c1, char c2)
+	{
+		return (int(static_cast<unsigned char>(c1))<<8) | int(static_cast<unsigned char>(c2));
+	}
 	//! returns the two/... first character of the main string in uppercase
 	std::string shortTitle(size_t sz=2) const
 	{
@@ -699,17 +721,23 @@ std::shared_ptr<WPSContentListener> XYWriteParser::createListener(librevenge::RV
 	ps.setMarginRight(0.1);
 	ps.setMarginTop(0.1);
 	ps.setMarginBottom(0.1);
+	// look for the formats in a copy of the main zone
 	input->seek(0, librevenge::RVNG_SEEK_SET);
-	while (!input->isEnd() && input->tell()<m_state->m_eof)
+	unsigned long numRead;
+	auto const *dataPtr=input->read(static_cast<unsigned long>(std::max(m_state->m_eof,0L)), numRead);
+	std::vector<unsigned char> const data(dataPtr, dataPtr ? dataPtr+numRead : dataPtr);
+	size_t pos=0;
+	while (pos<data.size())
 	{
-		uint8_t c=libwps::readU8(input);
-		if (c==0x1a)
+		auto const *formatPtr=static_cast<unsigned char const *>(memchr(data.data()+pos, 0xae, data.size()-pos));
+		size_t const formatPos=formatPtr ? size_t(formatPtr-data.data()) : data.size();
+		if (!formatPtr || memchr(data.data()+pos, 0x1a, formatPos-pos))
 			break;
-		if (c!=0xae)
-			continue;
+		input->seek(long(formatPos)+1, librevenge::RVNG_SEEK_SET);
 		XYWriteParserInternal::Format format;
 		if (!parseFormat(format))
 			break;
+		pos=size_t(input->tell());
 		std::string const str=format.title();
 		std::string const sTitle=format.shortTitle();
 		if (str=="PG")
@@ -794,7 +822,7 @@ std::shared_ptr<WPSContentListener> XYWriteParser::createListener(librevenge::RV
 		}
 	}
 	pageList.push_back(ps);
-	auto listener=std::make_shared<WPSContentListener>(pageList, interface);
+	auto listener=std::make_shared<WPSContentListener>(pageList, interface, getParseContext());
 	listener->setMetaData(m_state->m_metaData);
 	return listener;
 }
@@ -853,34 +881,30 @@ bool XYWriteParser::findAllZones()
 		WPS_DEBUG_MSG(("XYWriteParser::findAllZones: can not find the input\n"));
 		return false;
 	}
+	input->seek(0, librevenge::RVNG_SEEK_END);
+	long const fileSize=input->tell();
 	input->seek(0, librevenge::RVNG_SEEK_SET);
-	bool ok=false;
-	while (!input->isEnd())
-	{
-		if (libwps::readU8(input)==0x1a)
-		{
-			ok=true;
-			break;
-		}
-	}
-	if (!ok)
+	// look for the two end zone markers in a copy of the file
+	unsigned long numRead;
+	auto const *data=input->read(static_cast<unsigned long>(fileSize), numRead);
+	auto const *endMain=data ? static_cast<unsigned char const *>(memchr(data, 0x1a, size_t(numRead))) : nullptr;
+	if (!endMain)
 	{
 		WPS_DEBUG_MSG(("XYWriteParser::findAllZones: can not find the end main zone marker\n"));
 		return false;
 	}
-	long endZone1=input->tell();
-	while (!input->isEnd())
+	long endZone1=long(endMain-data)+1;
+	auto const *endMeta=static_cast<unsigned char const *>(memchr(endMain+1, 0x1a, size_t(numRead)-size_t(endZone1)));
+	if (endMeta)
 	{
-		if (libwps::readU8(input)==0x1a)
-		{
-			WPSEntry entry;
-			entry.setBegin(endZone1);
-			entry.setEnd(input->tell());
-			parseMetaData(entry);
-			input->seek(entry.end(), librevenge::RVNG_SEEK_SET);
-			break;
-		}
+		WPSEntry entry;
+		entry.setBegin(endZone1);
+		entry.setEnd(long(endMeta-data)+1);
+		parseMetaData(entry);
+		input->seek(entry.end(), librevenge::RVNG_SEEK_SET);
 	}
+	else
+		input->seek(long(numRead), librevenge::RVNG_SEEK_SET);
 	// now normally 22 02 fe fc fe 01 00
 	if (m_state->m_eof!=input->tell()+7)
 	{
@@ -896,16 +920,52 @@ bool XYWriteParser::update(XYWriteParserInternal::Format const &format, libwps_t
 	if (!m_listener)
 		throw "no listener";
 	std::string const str=format.title();
-	std::string const sTitle=format.shortTitle();
-	if (sTitle=="MD" || sTitle=="RG" || sTitle=="SZ" ||
-	        sTitle=="FG")
+	enum { C_Unknown, C_Font, C_FontName, C_Paragraph, C_LeftMargin } command=C_Unknown;
+	using XYWriteParserInternal::Format;
+	switch (format.shortCode())
+	{
+	case Format::getCode('M','D'):
+	case Format::getCode('R','G'):
+	case Format::getCode('S','Z'):
+	case Format::getCode('F','G'):
+		command=C_Font;
+		break;
+	case Format::getCode('U','F'):
+		if (str.size()>2) command=C_FontName;
+		break;
+	case Format::getCode('F','C'):
+	case Format::getCode('F','L'):
+	case Format::getCode('F','R'):
+	case Format::getCode('J','U'):
+	case Format::getCode('N','J'):
+		if (str.size()==2) command=C_Paragraph;
+		break;
+	case Format::getCode('I','P'):
+	case Format::getCode('R','M'):
+	case Format::getCode('A','L'):
+	case Format::getCode('L','S'):
+	case Format::getCode('B','B'):
+	case Format::getCode('N','B'):
+	case Format::getCode('E','L'):
+	case Format::getCode('L','L'):
+	case Format::getCode('T','S'):
+	case Format::getCode('B','G'):
+		command=C_Paragraph;
+		break;
+	case Format::getCode('L','M'):
+		command=C_LeftMargin;
+		break;
+	default:
+		break;
+	}
+	if (command==C_Font)
 	{
 		auto font=m_listener->getFont();
 		if (!format.updateFont(font))
 			return false;
 		m_listener->setFont(font);
 	}
-	else if (sTitle=="UF" && str.size()>2)
+	else if (command==C_FontName)
 	{
 		auto font=m_listener->getFont();
 		font.m_name=libwps_tools_win::Font::unicodeString(format.m_string.substr(2), m_state->getFontType());
@@ -914,19 +974,14 @@ bool XYWriteParser::update(XYWriteParserInternal::Format const &format, libwps_t
 			fontType=newType;
 		m_listener->setFont(font);
 	}
-	else if (str=="FC" || str=="FL" || str=="FR" ||
-	         str=="JU" || str=="NJ" ||
-	         sTitle=="IP" || sTitle=="RM" ||
-	         sTitle=="AL" || sTitle=="LS" || sTitle=="BB" || sTitle=="NB" ||
-	         sTitle=="EL" || sTitle=="LL" || sTitle=="TS" ||
-	         sTitle=="BG")
+	else if (command==C_Paragraph)
 	{
 		auto paragraph=m_listener->getParagraph();
 		if (!format.updateParagraph(paragraph))
 			return false;
 		m_listener->setParagraph(paragraph);
 	}
-	else if (sTitle=="LM")
+	else if (command==C_LeftMargin)
 	{
 		size_t p=2;
 		double value;
@@ -1037,6 +1092,7 @@ bool XYWriteParser::parseTextZone(WPSEntry const &entry, std::string const &styl
 		throw (libwps::ParseException());
 	if (!entry.valid())
 		return true;
+	WPSProfiler::Zone profileZone(getParseContext()->getProfiler(), "XYWrite", "Text", entry.length());
 	input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
 	auto fontType=m_state->getFontType();
 	WPSFont defFont;
@@ -1061,8 +1117,29 @@ bool XYWriteParser::parseTextZone(WPSEntry const &entry, std::string const &styl
 			}
 		}
 	}
+	// a copy of the zone used to find and send the runs of basic characters
+	unsigned long numRead;
+	auto const *dataPtr=input->read(static_cast<unsigned long>(entry.length()), numRead);
+	std::vector<unsigned char> const data(dataPtr, dataPtr ? dataPtr+numRead : dataPtr);
+	input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
 	while (!input->isEnd() && input->tell()<entry.end())
 	{
+		getParseContext()->checkProgress(input);
+		auto dataPos=size_t(input->tell()-entry.begin());
+		if (dataPos<data.size() && !XYWriteParserInternal::isSpecialCharacter(data[dataPos]))
+		{
+			librevenge::RVNGString text;
+			for (; dataPos<data.size() && !XYWriteParserInternal::isSpecialCharacter(data[dataPos]); ++dataPos)
+			{
+				auto unicode=uint32_t(libwps_tools_win::Font::unicode(data[dataPos], fontType));
+				if (unicode!=0xfffd)
+					libwps::appendUnicode(unicode, text);
+			}
+			if (!text.empty())
+				m_listener->insertUnicodeString(text);
+			input->seek(entry.begin()+long(dataPos), librevenge::RVNG_SEEK_SET);
+			continue;
+		}
 		uint8_t c=libwps::readU8(input);
 		if (c==0x1a)
 		{
@@ -1623,6 +1700,7 @@ bool XYWriteParser::parseFormat(XYWriteParserInternal::Format &format)
 	RVNGInputStreamPtr input = getInput();
 	if (!input)
 		throw (libwps::ParseException());
+	getParseContext()->checkRecord();
 	format=XYWriteParserInternal::Format(m_state->m_isDosFile);
 	format.m_entry.setBegin(input->tell());
 	while (!input->isEnd())
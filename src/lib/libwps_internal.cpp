@@ -26,6 +26,7 @@
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -87,163 +88,163 @@ int32_t read32(librevenge::RVNGInputStream *input)
 	return int32_t(readU32(input));
 }
 
-bool readDouble4(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+//! tries to read num bytes, returns the data or nullptr and restores the position if the zone is too short
+static unsigned char const *readBytes(RVNGInputStreamPtr &input, unsigned long num)
 {
-	isNaN=false;
-	res = 0;
 	long pos = input->tell();
-	if (input->seek(4, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+4)
+	unsigned long numRead;
+	unsigned char const *data=input->read(num, numRead);
+	if (!data || numRead!=num)
 	{
-		WPS_DEBUG_MSG(("libwps::readDouble4: the zone seems too short\n"));
 		input->seek(pos, librevenge::RVNG_SEEK_SET);
-		return false;
+		return nullptr;
 	}
-	input->seek(pos, librevenge::RVNG_SEEK_SET);
+	return data;
+}
 
-	double mantisse = 0;
+//! returns the little endian 32 bits value stored in data
+static uint32_t getU32(unsigned char const *data)
+{
+	return uint32_t(data[0])|(uint32_t(data[1])<<8)|(uint32_t(data[2])<<16)|(uint32_t(data[3])<<24);
+}
+
+//! returns the double corresponding to a IEEE 754 binary64 representation
+static double getIEEEDouble(uint64_t bits)
+{
+	static_assert(std::numeric_limits<double>::is_iec559 && sizeof(double)==sizeof(uint64_t),
+	              "the double are not stored in IEEE 754 binary64");
+	double res;
+	std::memcpy(&res, &bits, sizeof(double));
+	return res;
+}
+
+bool readDouble4(unsigned char const *data, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
 	/** (first&3)==1: is used to decide if we store 100*N or N.,
 		(first&3)==2: indicates a basic int number (appears mainly when converting a dos file in a windows file)
 		(first&3)==3: Can this exist ? What does this mean: 100*a basic int ?
-		The other bytes seem to have classic meaning...
+		The other bytes seem to have classic meaning, ie. they are the
+		4 highest bytes of a IEEE 754 double.
 	*/
-	auto first = int(readU8(input));
+	auto first = int(data[0]);
+	uint32_t val=getU32(data);
 	if ((first&3)==2)
 	{
 		// so read it as a normal number
-		input->seek(-1, librevenge::RVNG_SEEK_CUR);
-		auto val=long(readU16(input)>>2);
-		val+=long(readU16(input))<<14;
-		if (val&0x20000000)
-			res = double(val-0x40000000);
+		auto iVal=long(val>>2);
+		if (iVal&0x20000000)
+			res = double(iVal-0x40000000);
 		else
-			res = double(val);
+			res = double(iVal);
 		return true;
 	}
-	mantisse = double(first & 0xFC)/256 + double(readU8(input));
-	auto mantExp = int(readU8(input));
-	mantisse = (mantisse/256 + double(0x10+(mantExp & 0x0F)))/16;
-	int exp = ((mantExp&0xF0)>>4)+int(readU8(input)<<4);
-	int sign = 1;
-	if (exp & 0x800)
-	{
-		exp &= 0x7ff;
-		sign = -1;
-	}
-
+	int exp = int((val>>20)&0x7ff);
 	if (exp == 0)
-	{
-		if (double(mantisse) > 1.-1e-4)  return true; // ok zero
-		// fixme find Nan representation
-		return false;
-	}
+		return true; // ok zero
 	if (exp == 0x7FF)
 	{
-		if (double(mantisse) > 1.-1e-4)
-		{
-			res=std::numeric_limits<double>::quiet_NaN();
-			isNaN=true;
-			/* 0x7FFFF.. are nan(infinite, ...):ok
-
-			   0xFFFFF.. are nan(in the sense, not a number but
-			   text...). In this case wps2csv and wps2text will
-			   display a nan. Not good, but difficult to retrieve the
-			   cell's content without excuting the formula associated
-			   to this cell :-~
-			 */
-			return true;
-		}
-		return false;
-	}
+		res=std::numeric_limits<double>::quiet_NaN();
+		isNaN=true;
+		/* 0x7FFFF.. are nan(infinite, ...):ok
 
-	exp -= 0x3ff;
-	res = std::ldexp(mantisse, exp);
-	if (sign == -1)
-	{
-		res *= -1.;
+		   0xFFFFF.. are nan(in the sense, not a number but
+		   text...). In this case wps2csv and wps2text will
+		   display a nan. Not good, but difficult to retrieve the
+		   cell's content without excuting the formula associated
+		   to this cell :-~
+		 */
+		return true;
 	}
+	res = getIEEEDouble(uint64_t(val&0xFFFFFFFC)<<32);
 	if (first & 1) res/=100;
 	if (first & 2)
 	{
 		// CHECKME...
-		WPS_DEBUG_MSG(("libwps::readDouble4: ARRGGGGGGGGGG find a float with first & 3 ARRGGGGGGGGGG in pos%lx,\n some float can be broken\n", static_cast<unsigned long>(pos)));
+		WPS_DEBUG_MSG(("libwps::readDouble4: ARRGGGGGGGGGG find a float with first & 3 ARRGGGGGGGGGG,\n some float can be broken\n"));
 	}
 	return true;
 }
 
-bool readDouble8(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+bool readDouble4(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 {
-	isNaN=false;
-	res = 0;
-	long pos = input->tell();
-	if (input->seek(8, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+8)
+	unsigned char const *data=readBytes(input, 4);
+	if (!data)
 	{
-		WPS_DEBUG_MSG(("libwps::readDouble8: the zone seems too short\n"));
-		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		WPS_DEBUG_MSG(("libwps::readDouble4: the zone seems too short\n"));
+		isNaN=false;
+		res=0;
 		return false;
 	}
-	input->seek(pos, librevenge::RVNG_SEEK_SET);
-	double mantisse = 0;
-	for (int i = 0; i < 6; i++)
-		mantisse = mantisse/256 + double(readU8(input));
-	auto mantExp = int(readU8(input));
-	mantisse = (mantisse/256 + double(0x10+(mantExp & 0x0F)))/16;
-	int exp = ((mantExp&0xF0)>>4)+int(readU8(input)<<4);
-	int sign = 1;
-	if (exp & 0x800)
-	{
-		exp &= 0x7ff;
-		sign = -1;
-	}
+	return readDouble4(data, res, isNaN);
+}
 
-	double const epsilon=1.e-5;
+bool readDouble8(unsigned char const *data, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	uint64_t val=uint64_t(getU32(data))|(uint64_t(getU32(data+4))<<32);
+	int exp = int((val>>52)&0x7ff);
 	if (exp == 0)
 	{
+		double const mantisse=1+std::ldexp(double(val&0xFFFFFFFFFFFFFULL), -52);
+		double const epsilon=1.e-5;
 		if (mantisse > 1-epsilon && mantisse < 1+epsilon)  return true; // ok zero
 		// fixme find Nan representation
 		return false;
 	}
 	if (exp == 0x7FF)
 	{
-		if (mantisse >= 1-epsilon)
-		{
-			res=std::numeric_limits<double>::quiet_NaN();
-			return true; // ok 0x7FF and 0xFFF are nan
-		}
-		return false;
-	}
-
-	exp -= 0x3ff;
-	res = std::ldexp(mantisse, exp);
-	if (sign == -1)
-	{
-		res *= -1.;
+		res=std::numeric_limits<double>::quiet_NaN();
+		return true; // ok 0x7FF and 0xFFF are nan
 	}
+	res = getIEEEDouble(val);
 	return true;
 }
 
-bool readDouble10(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+bool readDouble8(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 {
-	isNaN=false;
-	res = 0;
-	long pos = input->tell();
-	if (input->seek(10, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+10)
+	unsigned char const *data=readBytes(input, 8);
+	if (!data)
 	{
 		WPS_DEBUG_MSG(("libwps::readDouble8: the zone seems too short\n"));
-		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		isNaN=false;
+		res=0;
 		return false;
 	}
-	input->seek(pos, librevenge::RVNG_SEEK_SET);
-	double mantisse = 0;
-	for (int i = 0; i < 8; i++)
-		mantisse = mantisse/256 + double(readU8(input))/128;
-	auto exp = int(readU16(input));
+	return readDouble8(data, res, isNaN);
+}
+
+bool readDouble10(unsigned char const *data, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	uint64_t mant=uint64_t(getU32(data))|(uint64_t(getU32(data+4))<<32);
+	auto exp = int(data[8])|(int(data[9])<<8);
 	int sign = 1;
 	if (exp & 0x8000)
 	{
 		exp &= 0x7fff;
 		sign = -1;
 	}
+	/* the usual case: a normalized mantisse with at most 53 significant
+	   bits which corresponds to a normal double, ie. a number which
+	   was stored first in a binary64, we can directly build its
+	   representation */
+	int const dExp=exp-0x3fff+0x3ff;
+	if ((mant>>63) && (mant&0x7ff)==0 && dExp>0 && dExp<0x7ff)
+	{
+		uint64_t bits=((mant>>11)&0xFFFFFFFFFFFFFULL)|(uint64_t(dExp)<<52);
+		if (sign==-1) bits|=uint64_t(1)<<63;
+		res=getIEEEDouble(bits);
+		return true;
+	}
 
+	// the general case, the mantisse is computed as in the original code to retrieve the same rounding
+	double mantisse = 0;
+	for (int i = 0; i < 8; i++)
+		mantisse = mantisse/256 + double(data[i])/128;
 	double const epsilon=1.e-5;
 	if (exp == 0)
 	{
@@ -270,19 +271,24 @@ bool readDouble10(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 	return true;
 }
 
-bool readDouble2Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+bool readDouble10(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 {
-	isNaN=false;
-	res = 0;
-	long pos = input->tell();
-	if (input->seek(2, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+2)
+	unsigned char const *data=readBytes(input, 10);
+	if (!data)
 	{
-		WPS_DEBUG_MSG(("libwps::readDouble2Inv: the zone seems too short\n"));
-		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		WPS_DEBUG_MSG(("libwps::readDouble10: the zone seems too short\n"));
+		isNaN=false;
+		res=0;
 		return false;
 	}
-	input->seek(pos, librevenge::RVNG_SEEK_SET);
-	auto val=int(libwps::readU16(input));
+	return readDouble10(data, res, isNaN);
+}
+
+bool readDouble2Inv(unsigned char const *data, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	auto val=int(data[0])|(int(data[1])<<8);
 	int exp=val&0xf;
 	if ((exp&1)==1)
 	{
@@ -300,35 +306,95 @@ bool readDouble2Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 	return true;
 }
 
-bool readDouble4Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+bool readDouble2Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
 {
-	isNaN=false;
-	res = 0;
-	long pos = input->tell();
-	if (input->seek(4, librevenge::RVNG_SEEK_CUR) || input->tell()!=pos+4)
+	unsigned char const *data=readBytes(input, 2);
+	if (!data)
 	{
-		WPS_DEBUG_MSG(("libwps::readDouble4Inv: the zone seems too short\n"));
-		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		WPS_DEBUG_MSG(("libwps::readDouble2Inv: the zone seems too short\n"));
+		isNaN=false;
+		res=0;
 		return false;
 	}
-	input->seek(pos, librevenge::RVNG_SEEK_SET);
-	auto val=long(libwps::readU32(input));
+	return readDouble2Inv(data, res, isNaN);
+}
+
+bool readDouble4Inv(unsigned char const *data, double &res, bool &isNaN)
+{
+	isNaN=false;
+	res = 0;
+	auto val=long(getU32(data));
 	auto exp=int(val&0xf);
 	auto mantisse=int(val>>6);
 	if (val&0x20)
 		mantisse *= -1;
 	if (exp)
 	{
+		// the powers of 10 are exact, so this is the same as std::pow(10., exp)
+		static double const powers[16]= { 1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
 		if (val&0x10)
-			res=mantisse/std::pow(10., exp);
+			res=mantisse/powers[exp];
 		else
-			res=mantisse*std::pow(10., exp);
+			res=mantisse*powers[exp];
 		return true;
 	}
 	res=double(mantisse);
 	return true;
 }
 
+bool readDouble4Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN)
+{
+	unsigned char const *data=readBytes(input, 4);
+	if (!data)
+	{
+		WPS_DEBUG_MSG(("libwps::readDouble4Inv: the zone seems too short\n"));
+		isNaN=false;
+		res=0;
+		return false;
+	}
+	return readDouble4Inv(data, res, isNaN);
+}
+
+bool readDouble4List(RVNGInputStreamPtr &input, size_t num, std::vector<double> &res)
+{
+	if (!num) return true;
+	unsigned char const *data=readBytes(input, 4*num);
+	if (!data)
+	{
+		WPS_DEBUG_MSG(("libwps::readDouble4List: the zone seems too short\n"));
+		return false;
+	}
+	size_t const first=res.size();
+	res.resize(first+num);
+	bool isNaN;
+	for (size_t i=first; i<first+num; ++i, data+=4)
+	{
+		if (!readDouble4(data, res[i], isNaN))
+			res[i]=0;
+	}
+	return true;
+}
+
+bool readDouble8List(RVNGInputStreamPtr &input, size_t num, std::vector<double> &res)
+{
+	if (!num) return true;
+	unsigned char const *data=readBytes(input, 8*num);
+	if (!data)
+	{
+		WPS_DEBUG_MSG(("libwps::readDouble8List: the zone seems too short\n"));
+		return false;
+	}
+	size_t const first=res.size();
+	res.resize(first+num);
+	bool isNaN;
+	for (size_t i=first; i<first+num; ++i, data+=8)
+	{
+		if (!readDouble8(data, res[i], isNaN))
+			res[i]=0;
+	}
+	return true;
+}
+
 bool readData(RVNGInputStreamPtr &input, unsigned long size, librevenge::RVNGBinaryData &data)
 {
 	data.clear();
@@ -781,24 +847,93 @@ WPSEmbeddedObject::~WPSEmbeddedObject()
 {
 }
 
+bool WPSEmbeddedObject::addZone(RVNGInputStreamPtr &input, long size, std::string const &type)
+{
+	if (!input) return false;
+	long pos=input->tell();
+	if (size<=0 || input->seek(pos+size, librevenge::RVNG_SEEK_SET)!=0 || input->tell()!=pos+size)
+	{
+		input->seek(pos, librevenge::RVNG_SEEK_SET);
+		return false;
+	}
+	WPSEntry entry;
+	entry.setBegin(pos);
+	entry.setLength(size);
+	add(input, entry, type);
+	return true;
+}
+
+bool WPSEmbeddedObject::getData(size_t i, librevenge::RVNGBinaryData &data) const
+{
+	data.clear();
+	if (i<m_dataList.size() && !m_dataList[i].empty())
+	{
+		data=m_dataList[i];
+		return true;
+	}
+	if (i>=m_entryList.size() || i>=m_inputList.size() || !m_entryList[i].valid() || !m_inputList[i])
+		return false;
+	auto const &entry=m_entryList[i];
+	RVNGInputStreamPtr input=m_inputList[i];
+	if (!entry.name().empty())
+	{
+		if (!input->isStructured())
+		{
+			WPS_DEBUG_MSG(("WPSEmbeddedObject::getData: the input is not structured\n"));
+			return false;
+		}
+		input.reset(input->getSubStreamByName(entry.name().c_str()));
+		if (!input)
+		{
+			WPS_DEBUG_MSG(("WPSEmbeddedObject::getData: can not find the sub stream %s\n", entry.name().c_str()));
+			return false;
+		}
+	}
+	long actPos=input->tell();
+	bool ok=input->seek(entry.begin(), librevenge::RVNG_SEEK_SET)==0 && input->tell()==entry.begin() &&
+	        libwps::readData(input, static_cast<unsigned long>(entry.length()), data);
+	input->seek(actPos, librevenge::RVNG_SEEK_SET);
+	if (!ok)
+	{
+		WPS_DEBUG_MSG(("WPSEmbeddedObject::getData: can not read the data of the representation %d\n", int(i)));
+		data.clear();
+	}
+	return ok;
+}
+
+long WPSEmbeddedObject::getDataSize() const
+{
+	long size=0;
+	for (size_t i=0; i<std::max(m_dataList.size(), m_entryList.size()); ++i)
+	{
+		if (i<m_dataList.size() && !m_dataList[i].empty())
+			size+=long(m_dataList[i].size());
+		else if (i<m_entryList.size() && m_entryList[i].valid())
+			size+=m_entryList[i].length();
+	}
+	return size;
+}
+
 bool WPSEmbeddedObject::addTo(librevenge::RVNGPropertyList &propList) const
 {
 	bool firstSet=false;
 	librevenge::RVNGPropertyListVector auxiliarVector;
-	for (size_t i=0; i<m_dataList.size(); ++i)
+	size_t numData=std::max(m_dataList.size(), m_entryList.size());
+	for (size_t i=0; i<numData; ++i)
 	{
-		if (m_dataList[i].empty()) continue;
-		std::string type=m_typeList.size() ? m_typeList[i] : "image/pict";
+		librevenge::RVNGBinaryData data;
+		if (!getData(i, data) || data.empty()) continue;
+		std::string type=i<m_typeList.size() ? m_typeList[i] : "image/pict";
 		if (!firstSet)
 		{
 			propList.insert("librevenge:mime-type", type.c_str());
-			propList.insert("office:binary-data", m_dataList[i]);
+			propList.insert("office:binary-data", data);
 			firstSet=true;
 			continue;
 		}
 		librevenge::RVNGPropertyList auxiList;
 		auxiList.insert("librevenge:mime-type", type.c_str());
-		auxiList.insert("office:binary-data", m_dataList[i]);
+		auxiList.insert("office:binary-data", data);
 		auxiliarVector.append(auxiList);
 	}
 	if (!auxiliarVector.empty())
@@ -39,6 +39,8 @@
 #include <librevenge-stream/librevenge-stream.h>
 #include <librevenge/librevenge.h>
 
+#include "WPSEntry.h"
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -93,6 +95,7 @@ class WPSContentListener;
 class WPSEntry;
 class WPSFont;
 class WPSHeader;
+class WPSParseContext;
 class WPSPosition;
 class WPSSubDocument;
 
@@ -107,6 +110,8 @@ typedef std::shared_ptr<WPSListener> WPSListenerPtr;
 typedef std::shared_ptr<WPSContentListener> WPSContentListenerPtr;
 /** shared pointer to WPSHeader */
 typedef std::shared_ptr<WPSHeader> WPSHeaderPtr;
+/** shared pointer to WPSParseContext */
+typedef std::shared_ptr<WPSParseContext> WPSParseContextPtr;
 /** shared pointer to WPSSubDocument */
 typedef std::shared_ptr<WPSSubDocument> WPSSubDocumentPtr;
 
@@ -162,6 +167,16 @@ class GenericException
 {
 	// needless to say, we could flesh this class out a bit
 };
+
+class LimitException
+{
+	// needless to say, we could flesh this class out a bit
+};
+
+class CancelException
+{
+	// needless to say, we could flesh this class out a bit
+};
 }
 
 /* ---------- input ----------------- */
@@ -212,6 +227,29 @@ bool readDouble2Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN);
 //! read a double store with 4 bytes: exponent 3.5 bytes, mantisse 0.5 bytes
 bool readDouble4Inv(RVNGInputStreamPtr &input, double &res, bool &isNaN);
 
+/* the same functions which decode a double from a buffer, data must
+   contain at least 4, 8, 10, 2 and 4 bytes */
+
+//! decode a double store with 4 bytes: mantisse 2.5 bytes, exponent 1.5 bytes
+bool readDouble4(unsigned char const *data, double &res, bool &isNaN);
+//! decode a double store with 8 bytes: mantisse 6.5 bytes, exponent 1.5 bytes
+bool readDouble8(unsigned char const *data, double &res, bool &isNaN);
+//! decode a double store with 10 bytes: mantisse 8 bytes, exponent 2 bytes
+bool readDouble10(unsigned char const *data, double &res, bool &isNaN);
+//! decode a double store with 2 bytes: exponent 1.5 bytes, kind of mantisse 0.5 bytes
+bool readDouble2Inv(unsigned char const *data, double &res, bool &isNaN);
+//! decode a double store with 4 bytes: exponent 3.5 bytes, mantisse 0.5 bytes
+bool readDouble4Inv(unsigned char const *data, double &res, bool &isNaN);
+
+/** read num doubles stored with 4 bytes and append them to res, the invalid values are replaced by 0.
+
+	Returns false (and does not move the input) if the zone is too short */
+bool readDouble4List(RVNGInputStreamPtr &input, size_t num, std::vector<double> &res);
+/** read num doubles stored with 8 bytes and append them to res, the invalid values are replaced by 0.
+
+	Returns false (and does not move the input) if the zone is too short */
+bool readDouble8List(RVNGInputStreamPtr &input, size_t num, std::vector<double> &res);
+
 //! try to read sz bytes from input and store them in a librevenge::RVNGBinaryData
 bool readData(RVNGInputStreamPtr &input, unsigned long sz, librevenge::RVNGBinaryData &data);
 //! try to read the last bytes from input and store them in a librevenge::RVNGBinaryData
@@ -1071,12 +1109,14 @@ typedef WPSVec3<float> WPSVec3f;
 
 /** small class use to define a embedded object
 
-    \note mainly used to store picture
+    \note mainly used to store picture. The data of a representation can either
+    be stored in memory or be defined by a zone of a stream, in which case they are
+    only read when the object is sent to the interface.
  */
 struct WPSEmbeddedObject
 {
 	//! empty constructor
-	WPSEmbeddedObject() : m_size(), m_dataList(), m_typeList(), m_sent(false)
+	WPSEmbeddedObject() : m_size(), m_dataList(), m_typeList(), m_inputList(), m_entryList(), m_sent(false)
 	{
 	}
 	WPSEmbeddedObject(WPSEmbeddedObject const &) = default;
@@ -1085,7 +1125,7 @@ struct WPSEmbeddedObject
 	WPSEmbeddedObject &operator=(WPSEmbeddedObject &&) = default;
 	//! constructor
 	WPSEmbeddedObject(librevenge::RVNGBinaryData const &binaryData,
-	                  std::string const &type="image/pict") : m_size(), m_dataList(), m_typeList(), m_sent(false)
+	                  std::string const &type="image/pict") : m_size(), m_dataList(), m_typeList(), m_inputList(), m_entryList(), m_sent(false)
 	{
 		add(binaryData, type);
 	}
@@ -1099,18 +1139,37 @@ struct WPSEmbeddedObject
 			if (!data.empty())
 				return false;
 		}
+		for (auto const &entry : m_entryList)
+		{
+			if (entry.valid())
+				return false;
+		}
 		return true;
 	}
 	//! add a picture
 	void add(librevenge::RVNGBinaryData const &binaryData, std::string const &type="image/pict")
 	{
-		size_t pos=m_dataList.size();
-		if (pos<m_typeList.size()) pos=m_typeList.size();
-		m_dataList.resize(pos+1);
+		size_t pos=getNewRepresentationId();
 		m_dataList[pos]=binaryData;
-		m_typeList.resize(pos+1);
 		m_typeList[pos]=type;
 	}
+	/** add a picture stored in a zone of input, the data will only be read when needed
+
+		\note if the entry's name is not empty, the zone is stored in the sub stream with this name*/
+	void add(RVNGInputStreamPtr const &input, WPSEntry const &entry, std::string const &type="image/pict")
+	{
+		size_t pos=getNewRepresentationId();
+		m_inputList[pos]=input;
+		m_entryList[pos]=entry;
+		m_typeList[pos]=type;
+	}
+	/** checks that input contains size bytes after the actual position and adds this zone
+		as a not yet read picture. If it succeeds, the input is positioned after the zone. */
+	bool addZone(RVNGInputStreamPtr &input, long size, std::string const &type="image/pict");
+	//! try to retrieve the data of the i^th representation (reading them if needed)
+	bool getData(size_t i, librevenge::RVNGBinaryData &data) const;
+	//! returns the total size of the representations' data
+	long getDataSize() const;
 	/** add the link property to proplist */
 	bool addTo(librevenge::RVNGPropertyList &propList) const;
 	/** operator<<*/
@@ -1122,8 +1181,24 @@ struct WPSEmbeddedObject
 	std::vector<librevenge::RVNGBinaryData> m_dataList;
 	//! the picture type: one type by representation
 	std::vector<std::string> m_typeList;
+	//! the input which stores the not yet read data: one input by representation
+	std::vector<RVNGInputStreamPtr> m_inputList;
+	//! the zone which stores the not yet read data: one entry by representation
+	std::vector<WPSEntry> m_entryList;
 	//! a mutable flag which can be used to know if the picture was send to a listener
 	mutable bool m_sent;
+protected:
+	//! resizes the lists to add a new representation and returns its id
+	size_t getNewRepresentationId()
+	{
+		size_t pos=std::max(m_dataList.size(), m_typeList.size());
+		pos=std::max(pos, std::max(m_inputList.size(), m_entryList.size()));
+		m_dataList.resize(pos+1);
+		m_typeList.resize(pos+1);
+		m_inputList.resize(pos+1);
+		m_entryList.resize(pos+1);
+		return pos;
+	}
 };
 
 /** a transformation which stored the first row of a 3x3 perspective matrix */